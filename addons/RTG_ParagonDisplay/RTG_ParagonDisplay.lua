@@ -5,6 +5,9 @@
 --   Client whisper LANG_ADDON:  "RTG_PARAGON\tQ:<name>"
 --   Server legacy reply:        "RTG_PARAGON\tA:<name>:<paragon>"
 --   Server extended reply:      "RTG_PARAGON\tB:<name>:<paragon>:<kind>"
+--   Client guild standings:     "RTG_PARAGON\tG?"
+--   Server guild reply:         "RTG_PARAGON\tG:<members>:<total>:<average>:<max>:<at50>:<at100>:<at150>:<at200>"
+--                               ("G:0" when not in a guild)
 --
 -- kind values:
 --   real        = normal player
@@ -465,6 +468,11 @@ end
 
 -- ------------------------------- Slash commands -------------------------------
 
+SLASH_RTGGUILD1 = "/rtgguild"
+SlashCmdList["RTGGUILD"] = function()
+  SendParagonAddon("G?")
+end
+
 SLASH_RTGWHO1 = "/rtgwho"
 SLASH_RTGWHO2 = "/whohidebots"
 SlashCmdList["RTGWHO"] = function(command)
@@ -549,6 +557,20 @@ loader:SetScript("OnEvent", function(_, event, a, b, c, d)
       return
     end
 
+    -- Guild paragon standings: "G:<members>:<total>:<average>:<max>:<at50>:<at100>:<at150>:<at200>"
+    if message == "G:0" then
+      msg("You are not in a guild.")
+      return
+    end
+
+    local members, total, average, maxLevel, at50, at100, at150, at200 =
+      message:match("^G:(%d+):(%d+):([%d%.]+):(%d+):(%d+):(%d+):(%d+):(%d+)$")
+    if members then
+      msg("Guild Paragon: " .. members .. " members, total " .. total .. ", average " .. average .. ", highest " .. maxLevel)
+      msg("Milestones: 50+: " .. at50 .. "  100+: " .. at100 .. "  150+: " .. at150 .. "  200+: " .. at200)
+      return
+    end
+
     -- Extended message format from server: "B:<name>:<paragon>:<kind>"
     local name, lvl, kind = message:match("^B:([^:]+):(%d+):([^:]+)$")
     if name and lvl and kind then
@@ -0,0 +1,17 @@
+-- Guild paragon standings maintained by mod-paragon-levels.
+-- Rebuilt on worldserver startup and updated in batches (ParagonLevel.GuildSummary.FlushInterval).
+-- Read-only for the website; do not write to it.
+
+CREATE TABLE IF NOT EXISTS `character_paragon_guild_summary` (
+  `guildid` INT UNSIGNED NOT NULL,
+  `members` INT UNSIGNED NOT NULL DEFAULT 0,
+  `total` BIGINT UNSIGNED NOT NULL DEFAULT 0,
+  `average` FLOAT NOT NULL DEFAULT 0,
+  `max` INT UNSIGNED NOT NULL DEFAULT 0,
+  `at50` INT UNSIGNED NOT NULL DEFAULT 0,
+  `at100` INT UNSIGNED NOT NULL DEFAULT 0,
+  `at150` INT UNSIGNED NOT NULL DEFAULT 0,
+  `at200` INT UNSIGNED NOT NULL DEFAULT 0,
+  `updated_at` INT UNSIGNED NOT NULL DEFAULT 0,
+  PRIMARY KEY (`guildid`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
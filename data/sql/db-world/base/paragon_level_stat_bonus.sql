@@ -0,0 +1,18 @@
+-- Per paragon level stat bonuses for mod-paragon-levels.
+-- A character at Paragon N receives the sum of every row with level <= N.
+-- level starts at 1; rows with level 0 are rejected on load.
+--
+-- stat:
+--   0 = stamina        5 = attack power (melee + ranged)
+--   1 = strength       6 = spell power
+--   2 = agility        7 = armor
+--   3 = intellect      8 = health
+--   4 = spirit
+
+CREATE TABLE IF NOT EXISTS `paragon_level_stat_bonus` (
+  `level` INT UNSIGNED NOT NULL,
+  `stat` TINYINT UNSIGNED NOT NULL,
+  `value` INT NOT NULL DEFAULT 0,
+  `comment` VARCHAR(255) NOT NULL DEFAULT '',
+  PRIMARY KEY (`level`, `stat`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
@@ -0,0 +1,74 @@
+#ifndef RTG_PARAGON_CURVE_H
+#define RTG_PARAGON_CURVE_H
+
+// Paragon XP curve and milestone rules.
+//
+// Kept free of AzerothCore headers so the offline progression simulator
+// (tools/paragon_sim) runs exactly the same math as the worldserver.
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+
+namespace RTG::ParagonCurve
+{
+    // ON_PLAYER_LEVEL_UP_PARAGON_5_INTERVAL fires every REWARD_INTERVAL paragon levels.
+    static constexpr uint32_t REWARD_INTERVAL = 5;
+
+    // Levels that publish a PARAGON_LEVEL scoreboard telemetry event.
+    static constexpr uint32_t TELEMETRY_MILESTONES[] = { 25, 50, 75, 100, 125, 150, 175, 200 };
+
+    // Levels with a milestone title slot: ParagonLevel.TitleAt50 / 100 / 150 / 200.
+    static constexpr uint32_t TITLE_MILESTONES[] = { 50, 100, 150, 200 };
+    static constexpr size_t TITLE_MILESTONE_COUNT = std::size(TITLE_MILESTONES);
+
+    // XP needed to go from `paragonLevel` to the next one. `baseXp` is the core's
+    // XP-for-level at max player level. Unreachable at the cap.
+    inline uint32_t XpForNextLevel(uint32_t baseXp, uint32_t paragonLevel, float xpPerLevelMod, uint32_t maxParagonLevel)
+    {
+        if (paragonLevel >= maxParagonLevel)
+        {
+            // Make next level unreachable at cap (prevents spam/loops)
+            return std::numeric_limits<uint32_t>::max();
+        }
+
+        if (xpPerLevelMod <= 1.0f)
+            return baseXp;
+
+        float mod = 1.0f + ((paragonLevel * xpPerLevelMod) / 100.0f);
+        return static_cast<uint32_t>(baseXp * mod);
+    }
+
+    // `interval` is only overridden by paragon_sim to try other reward spacings.
+    inline bool IsRewardInterval(uint32_t paragonLevel, uint32_t interval = REWARD_INTERVAL)
+    {
+        return interval && paragonLevel % interval == 0;
+    }
+
+    inline bool IsTelemetryMilestone(uint32_t paragonLevel)
+    {
+        for (uint32_t milestone : TELEMETRY_MILESTONES)
+            if (milestone == paragonLevel)
+                return true;
+
+        return false;
+    }
+
+    // Index into TITLE_MILESTONES, or TITLE_MILESTONE_COUNT if the level has no title slot.
+    inline size_t TitleMilestoneIndex(uint32_t paragonLevel)
+    {
+        for (size_t i = 0; i < TITLE_MILESTONE_COUNT; ++i)
+            if (TITLE_MILESTONES[i] == paragonLevel)
+                return i;
+
+        return TITLE_MILESTONE_COUNT;
+    }
+
+    inline bool IsTitleMilestone(uint32_t paragonLevel)
+    {
+        return TitleMilestoneIndex(paragonLevel) < TITLE_MILESTONE_COUNT;
+    }
+}
+
+#endif
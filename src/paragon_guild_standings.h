@@ -0,0 +1,331 @@
+#ifndef RTG_PARAGON_GUILD_STANDINGS_H
+#define RTG_PARAGON_GUILD_STANDINGS_H
+
+// Per-guild paragon aggregates (total, average, max, members past each milestone).
+//
+// Built by one scan of guild_member at startup and then kept current from the module's
+// hooks: paragon gain, guild join/leave/disband and character deletion. Dirty guilds are
+// written to characters.character_paragon_guild_summary in one batched transaction so the
+// website can read standings without a GROUP BY over character_currencies.
+
+#include "DatabaseEnv.h"
+#include "Define.h"
+#include "Log.h"
+#include "Timer.h"
+#include "paragon_curve.h"
+
+#include <array>
+#include <ctime>
+#include <fmt/format.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace RTG::ParagonGuild
+{
+    static constexpr char const* SUMMARY_TABLE = "character_paragon_guild_summary";
+
+    // Members at or above each title milestone are counted per guild.
+    static constexpr auto const& MILESTONES = RTG::ParagonCurve::TITLE_MILESTONES;
+    static_assert(RTG::ParagonCurve::TITLE_MILESTONE_COUNT == 4, "summary table has one atN column per milestone");
+
+    struct Summary
+    {
+        uint32 members = 0;
+        uint64 total = 0;
+        uint32 max = 0;
+        std::array<uint32, RTG::ParagonCurve::TITLE_MILESTONE_COUNT> atMilestone = { };
+
+        float Average() const { return members ? float(total) / float(members) : 0.0f; }
+    };
+
+    class Standings
+    {
+    public:
+        static void EnsureSchema()
+        {
+            CharacterDatabase.DirectExecute(fmt::format(
+                "CREATE TABLE IF NOT EXISTS `{}` ("
+                "`guildid` INT UNSIGNED NOT NULL,"
+                "`members` INT UNSIGNED NOT NULL DEFAULT 0,"
+                "`total` BIGINT UNSIGNED NOT NULL DEFAULT 0,"
+                "`average` FLOAT NOT NULL DEFAULT 0,"
+                "`max` INT UNSIGNED NOT NULL DEFAULT 0,"
+                "`at50` INT UNSIGNED NOT NULL DEFAULT 0,"
+                "`at100` INT UNSIGNED NOT NULL DEFAULT 0,"
+                "`at150` INT UNSIGNED NOT NULL DEFAULT 0,"
+                "`at200` INT UNSIGNED NOT NULL DEFAULT 0,"
+                "`updated_at` INT UNSIGNED NOT NULL DEFAULT 0,"
+                "PRIMARY KEY (`guildid`)"
+                ") ENGINE=InnoDB DEFAULT CHARSET=utf8mb4",
+                SUMMARY_TABLE));
+        }
+
+        // Full scan, only done once at startup. Every guild is flushed afterwards; the
+        // caller flushes right away so the summary table is current from the start.
+        void Load()
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            _guilds.clear();
+            _members.clear();
+            _pendingRebuild.clear();
+
+            QueryResult result = CharacterDatabase.Query(
+                "SELECT gm.guildid, gm.guid, COALESCE(cc.ParagonLevel, 0) FROM guild_member gm "
+                "LEFT JOIN character_currencies cc ON cc.guid = gm.guid");
+            if (result)
+            {
+                do
+                {
+                    Field* fields = result->Fetch();
+                    AddMemberLocked(fields[0].Get<uint32>(), fields[1].Get<uint32>(), fields[2].Get<uint32>());
+                } while (result->NextRow());
+            }
+
+            for (auto const& [guildId, guild] : _guilds)
+                _dirty.insert(guildId);
+
+            // Rows of guilds that no longer exist must not survive a restart. Marking them dirty
+            // deletes them in the same transaction that rewrites the others, so the website
+            // never reads a half-empty table.
+            if (QueryResult stored = CharacterDatabase.Query("SELECT guildid FROM `{}`", SUMMARY_TABLE))
+            {
+                do
+                {
+                    uint32 const guildId = stored->Fetch()[0].Get<uint32>();
+                    if (!_guilds.count(guildId))
+                        _dirty.insert(guildId);
+                } while (stored->NextRow());
+            }
+
+            LOG_INFO("module", "ParagonGuild: loaded standings for {} guilds ({} members).", _guilds.size(), _members.size());
+        }
+
+        void AddMember(uint32 guildId, uint32 guid, uint32 paragon)
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            RemoveMemberLocked(guid);
+            AddMemberLocked(guildId, guid, paragon);
+        }
+
+        void RemoveMember(uint32 guid)
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            RemoveMemberLocked(guid);
+        }
+
+        // Paragon gain of a tracked member; unguilded characters are a single failed lookup.
+        void SetParagon(uint32 guid, uint32 paragon)
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+
+            auto itr = _members.find(guid);
+            if (itr == _members.end() || itr->second.paragon == paragon)
+                return;
+
+            GuildEntry& guild = _guilds[itr->second.guildId];
+            Unaccount(guild, itr->second.paragon);
+            Account(guild, paragon);
+            itr->second.paragon = paragon;
+            _dirty.insert(itr->second.guildId);
+        }
+
+        void Disband(uint32 guildId)
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+
+            auto itr = _guilds.find(guildId);
+            if (itr == _guilds.end())
+                return;
+
+            for (uint32 guid : itr->second.memberGuids)
+                _members.erase(guid);
+
+            _guilds.erase(itr);
+            _pendingRebuild.erase(guildId);
+            _dirty.insert(guildId);
+        }
+
+        // The core reports offline joins/leaves without a Player, so the member is unknown.
+        // Such guilds are re-read from guild_member by a later Flush(), once the request is
+        // old enough for the core's own async guild_member write to have landed. A repeated
+        // request restarts the wait.
+        void RequestRebuild(uint32 guildId)
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            _pendingRebuild[guildId] = getMSTime();
+        }
+
+        bool Get(uint32 guildId, Summary& out) const
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+
+            auto itr = _guilds.find(guildId);
+            if (itr == _guilds.end())
+                return false;
+
+            out = itr->second.summary;
+            out.max = itr->second.levelCounts.empty() ? 0 : itr->second.levelCounts.rbegin()->first;
+            return true;
+        }
+
+        // Rebuilds guilds whose rebuild request is at least `rebuildDelayMs` old, then writes
+        // every dirty guild in one transaction. Younger requests wait for a later flush.
+        void Flush(uint32 rebuildDelayMs)
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+
+            uint32 const nowMs = getMSTime();
+            for (auto itr = _pendingRebuild.begin(); itr != _pendingRebuild.end();)
+            {
+                if (getMSTimeDiff(itr->second, nowMs) < rebuildDelayMs)
+                {
+                    ++itr;
+                    continue;
+                }
+
+                RebuildLocked(itr->first);
+                itr = _pendingRebuild.erase(itr);
+            }
+
+            if (_dirty.empty())
+                return;
+
+            uint32 const now = uint32(std::time(nullptr));
+            CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+            std::string values;
+            std::string deleted;
+
+            for (uint32 guildId : _dirty)
+            {
+                auto itr = _guilds.find(guildId);
+                if (itr == _guilds.end())
+                {
+                    deleted += fmt::format("{}{}", deleted.empty() ? "" : ",", guildId);
+                    continue;
+                }
+
+                Summary const& s = itr->second.summary;
+                uint32 const max = itr->second.levelCounts.empty() ? 0 : itr->second.levelCounts.rbegin()->first;
+                values += fmt::format("{}({},{},{},{},{},{},{},{},{},{})", values.empty() ? "" : ",",
+                    guildId, s.members, s.total, s.Average(), max,
+                    s.atMilestone[0], s.atMilestone[1], s.atMilestone[2], s.atMilestone[3], now);
+            }
+
+            if (!values.empty())
+                trans->Append(fmt::format(
+                    "REPLACE INTO `{}` (guildid, members, total, average, max, at50, at100, at150, at200, updated_at) VALUES {}",
+                    SUMMARY_TABLE, values));
+
+            if (!deleted.empty())
+                trans->Append(fmt::format("DELETE FROM `{}` WHERE guildid IN ({})", SUMMARY_TABLE, deleted));
+
+            CharacterDatabase.CommitTransaction(trans);
+            _dirty.clear();
+        }
+
+    private:
+        struct GuildEntry
+        {
+            Summary summary;                      // max is derived from levelCounts
+            std::map<uint32, uint32> levelCounts; // paragon -> members, ordered for max
+            std::unordered_set<uint32> memberGuids;
+        };
+
+        struct MemberEntry
+        {
+            uint32 guildId = 0;
+            uint32 paragon = 0;
+        };
+
+        static void Account(GuildEntry& guild, uint32 paragon)
+        {
+            guild.summary.total += paragon;
+            ++guild.levelCounts[paragon];
+            for (size_t i = 0; i < RTG::ParagonCurve::TITLE_MILESTONE_COUNT; ++i)
+                if (paragon >= MILESTONES[i])
+                    ++guild.summary.atMilestone[i];
+        }
+
+        static void Unaccount(GuildEntry& guild, uint32 paragon)
+        {
+            guild.summary.total -= paragon;
+            auto itr = guild.levelCounts.find(paragon);
+            if (itr != guild.levelCounts.end() && --itr->second == 0)
+                guild.levelCounts.erase(itr);
+            for (size_t i = 0; i < RTG::ParagonCurve::TITLE_MILESTONE_COUNT; ++i)
+                if (paragon >= MILESTONES[i])
+                    --guild.summary.atMilestone[i];
+        }
+
+        void AddMemberLocked(uint32 guildId, uint32 guid, uint32 paragon)
+        {
+            GuildEntry& guild = _guilds[guildId];
+            if (!guild.memberGuids.insert(guid).second)
+                return;
+
+            ++guild.summary.members;
+            Account(guild, paragon);
+            _members[guid] = { guildId, paragon };
+            _dirty.insert(guildId);
+        }
+
+        void RemoveMemberLocked(uint32 guid)
+        {
+            auto itr = _members.find(guid);
+            if (itr == _members.end())
+                return;
+
+            uint32 const guildId = itr->second.guildId;
+            auto guildItr = _guilds.find(guildId);
+            if (guildItr != _guilds.end())
+            {
+                GuildEntry& guild = guildItr->second;
+                --guild.summary.members;
+                Unaccount(guild, itr->second.paragon);
+                guild.memberGuids.erase(guid);
+                if (guild.memberGuids.empty())
+                    _guilds.erase(guildItr);
+            }
+
+            _members.erase(itr);
+            _dirty.insert(guildId);
+        }
+
+        void RebuildLocked(uint32 guildId)
+        {
+            if (auto itr = _guilds.find(guildId); itr != _guilds.end())
+            {
+                for (uint32 guid : itr->second.memberGuids)
+                    _members.erase(guid);
+                _guilds.erase(itr);
+            }
+
+            QueryResult result = CharacterDatabase.Query(
+                "SELECT gm.guid, COALESCE(cc.ParagonLevel, 0) FROM guild_member gm "
+                "LEFT JOIN character_currencies cc ON cc.guid = gm.guid WHERE gm.guildid = {}", guildId);
+            if (result)
+            {
+                do
+                {
+                    Field* fields = result->Fetch();
+                    uint32 const guid = fields[0].Get<uint32>();
+                    RemoveMemberLocked(guid);
+                    AddMemberLocked(guildId, guid, fields[1].Get<uint32>());
+                } while (result->NextRow());
+            }
+
+            _dirty.insert(guildId);
+        }
+
+        mutable std::mutex _lock;
+        std::unordered_map<uint32, GuildEntry> _guilds;    // guildId -> aggregates
+        std::unordered_map<uint32, MemberEntry> _members;  // character guid -> guild / paragon
+        std::unordered_set<uint32> _dirty;                 // guilds to write on next Flush()
+        std::unordered_map<uint32, uint32> _pendingRebuild; // guildId -> getMSTime() of the request
+    };
+}
+
+#endif
@@ -20,6 +20,16 @@
  * - This file assumes you have RewardSystem available as sRewardSystem.
  * - Per-character toggles are stored in Characters DB table: character_paragon_settings
  *   (guid PK, enable_chat_color tinyint, hide_who_bots tinyint)
+ * - Level-up side effects (spell, rewards, chat, titles, telemetry) are NOT run inside the XP hook.
+ *   They are queued per player and drained by the world update tick within ParagonLevel.Dispatch.BudgetMs.
+ * - Optional read-only snapshot for external scoreboard readers (ParagonLevel.Snapshot.Path):
+ *   memory-mapped, seqlock-protected records, see paragon_snapshot_format.h and tools/paragon_snapshot.
+ * - Per-level stat bonuses from World DB table paragon_level_stat_bonus, precomputed as prefix sums
+ *   so login/level-up only applies the difference between two totals.
+ * - Guild paragon standings kept in memory (.paragon guild, addon "G?") and flushed in batches to
+ *   character_paragon_guild_summary, see paragon_guild_standings.h.
+ * - Online player index (paragon, kind, hide_who_bots) behind the /who predicate API in
+ *   paragon_who_filter.h, so the core's HandleWhoOpcode never needs the database.
  */
 
 #include "AccountMgr.h"
@@ -29,15 +39,21 @@
 #include "Config.h"
 #include "DatabaseEnv.h"
 #include "DBCStores.h"
+#include "Guild.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "Opcodes.h"
 #include "Player.h"
 #include "RewardSystem.h"
 #include "ScriptMgr.h"
+#include "Timer.h"
 #include "World.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
+#include "paragon_curve.h"
+#include "paragon_guild_standings.h"
+#include "paragon_snapshot_writer.h"
+#include "paragon_who_filter.h"
 #include "rtg_scoreboard_telemetry_sink.h"
 
 #if __has_include("RandomPlayerbotMgr.h")
@@ -52,9 +68,15 @@
 
 #include <fmt/format.h>
 #include <algorithm>
+#include <array>
 #include <cctype>
+#include <deque>
+#include <iterator>
 #include <limits>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -63,6 +85,48 @@ namespace
     // Characters DB (per-character) settings.
     static constexpr char const* PARAGON_SETTINGS_TABLE = "character_paragon_settings";
 
+    // RewardSystem events raised by a paragon level-up, resolved to a dense ID once.
+    // The key strings are built a single time and only handed over when a batch is drained.
+    enum ParagonRewardEvent : uint8
+    {
+        PARAGON_REWARD_LEVEL_UP            = 0,
+        PARAGON_REWARD_LEVEL_UP_5_INTERVAL = 1,
+        MAX_PARAGON_REWARD_EVENTS
+    };
+
+    static std::string const ParagonRewardEventKeys[MAX_PARAGON_REWARD_EVENTS] =
+    {
+        "ON_PLAYER_LEVEL_UP_PARAGON",
+        "ON_PLAYER_LEVEL_UP_PARAGON_5_INTERVAL",
+    };
+
+    // Level-up side effects waiting for the world update tick. Consecutive level-ups of the
+    // same player before a drain are folded into one entry.
+    struct PendingParagonLevelUp
+    {
+        uint32 fromParagonLevel = 0; // paragon level before the first queued gain
+        uint32 toParagonLevel = 0;   // latest paragon level reached
+        std::array<uint32, MAX_PARAGON_REWARD_EVENTS> rewardCounts = { };
+    };
+
+    // World DB: paragon_level_stat_bonus.stat
+    enum ParagonStatBonus : uint8
+    {
+        PARAGON_STAT_STAMINA      = 0,
+        PARAGON_STAT_STRENGTH     = 1,
+        PARAGON_STAT_AGILITY      = 2,
+        PARAGON_STAT_INTELLECT    = 3,
+        PARAGON_STAT_SPIRIT       = 4,
+        PARAGON_STAT_ATTACK_POWER = 5, // melee and ranged
+        PARAGON_STAT_SPELL_POWER  = 6,
+        PARAGON_STAT_ARMOR        = 7,
+        PARAGON_STAT_HEALTH       = 8,
+        MAX_PARAGON_STAT_BONUSES
+    };
+
+    // Bonus totals granted at a given paragon level (sum of every row up to and including it).
+    using ParagonStatTotals = std::array<int32, MAX_PARAGON_STAT_BONUSES>;
+
     static void EnsureParagonSettingsSchema()
     {
         CharacterDatabase.DirectExecute(fmt::format(
@@ -131,44 +195,87 @@ namespace
             PARAGON_SETTINGS_TABLE, guidLow, hidden ? 1 : 0));
     }
 
-    static std::vector<std::string> SplitTab(std::string const& s)
+    static constexpr std::string_view RTG_PARAGON_ADDON_PREFIX = "RTG_PARAGON";
+
+    // SMSG_MESSAGECHAT addon whisper layout:
+    //   uint8 type, uint32 lang, uint64 sender, uint32 flags, uint64 receiver,
+    //   uint32 msg length, "PREFIX\tDATA\0", uint8 chat tag
+    static constexpr size_t ADDON_WHISPER_SENDER_GUID_POS   = 1 + 4;
+    static constexpr size_t ADDON_WHISPER_RECEIVER_GUID_POS = 1 + 4 + 8 + 4;
+    static constexpr size_t ADDON_WHISPER_HEADER_SIZE       = 1 + 4 + 8 + 4 + 8 + 4;
+
+    // Per-thread scratch for addon replies. The reply text and the packet keep their capacity
+    // between replies, so steady-state replies do not allocate before the session queues them.
+    struct AddonReplyPool
     {
-        std::vector<std::string> out;
-        size_t start = 0;
-        while (true)
-        {
-            size_t pos = s.find('\t', start);
-            if (pos == std::string::npos)
-            {
-                out.push_back(s.substr(start));
-                break;
-            }
-            out.push_back(s.substr(start, pos - start));
-            start = pos + 1;
-        }
-        return out;
+        fmt::memory_buffer text;
+        WorldPacket packet;
+    };
+
+    static AddonReplyPool& GetAddonReplyPool()
+    {
+        thread_local AddonReplyPool pool;
+        return pool;
     }
 
-    // Build an SMSG_MESSAGECHAT packet that matches client "addon whisper" expectations.
+    // Serialize an SMSG_MESSAGECHAT that matches client "addon whisper" expectations into `pkt`.
     // Format of payload in WotLK/AC examples is: "PREFIX\tDATA"
-    static WorldPacket CreateAddonWhisperPacket(std::string const& prefix, std::string const& data, Player* receiver)
+    static void WriteAddonWhisperPacket(WorldPacket& pkt, std::string_view prefix, std::string_view data, uint64 guid)
     {
-        std::string full = prefix + "\t" + data;
-        uint32 len = static_cast<uint32>(full.size());
+        uint32 len = static_cast<uint32>(prefix.size() + 1 + data.size());
 
-        WorldPacket pkt;
-        pkt.Initialize(SMSG_MESSAGECHAT, 1 + 4 + 8 + 4 + 8 + 4 + len + 1);
+        pkt.Initialize(SMSG_MESSAGECHAT, ADDON_WHISPER_HEADER_SIZE + len + 2);
 
         pkt << uint8(CHAT_MSG_WHISPER);                      // type
         pkt << uint32(LANG_ADDON);                           // lang
-        pkt << uint64(receiver->GetGUID().GetRawValue());    // sender guid (server->client, ok to use receiver guid here)
+        pkt << uint64(guid);                                 // sender guid (server->client, ok to use receiver guid here)
         pkt << uint32(0);                                    // flags
-        pkt << uint64(receiver->GetGUID().GetRawValue());    // receiver guid
+        pkt << uint64(guid);                                 // receiver guid
         pkt << uint32(len + 1);                              // msg length
-        pkt << full;                                         // msg
+        pkt.append(prefix.data(), prefix.size());            // msg
+        pkt << uint8('\t');
+        pkt.append(data.data(), data.size());
+        pkt << uint8(0);                                     // msg terminator
         pkt << uint8(0);                                     // chat tag / null
+    }
+
+    template <typename... Args>
+    static void SendAddonReply(Player* receiver, fmt::format_string<Args...> format, Args&&... args)
+    {
+        AddonReplyPool& pool = GetAddonReplyPool();
+        pool.text.clear();
+        fmt::format_to(std::back_inserter(pool.text), format, std::forward<Args>(args)...);
+
+        WriteAddonWhisperPacket(pool.packet, RTG_PARAGON_ADDON_PREFIX,
+            std::string_view(pool.text.data(), pool.text.size()), receiver->GetGUID().GetRawValue());
+        receiver->SendDirectMessage(&pool.packet);
+    }
 
-        return pkt;
+    // "W:0" / "W:1" only differ per player in the two GUID fields, so both are serialized once
+    // and copied into the pooled packet with the receiver GUID patched in.
+    static void SendWhoBotsReply(Player* receiver, bool hidden)
+    {
+        static std::array<std::vector<uint8>, 2> const templates = []()
+        {
+            std::array<std::vector<uint8>, 2> out;
+            for (uint8 i = 0; i < 2; ++i)
+            {
+                WorldPacket pkt;
+                WriteAddonWhisperPacket(pkt, RTG_PARAGON_ADDON_PREFIX, i ? "W:1" : "W:0", 0);
+                out[i].assign(pkt.contents(), pkt.contents() + pkt.size());
+            }
+            return out;
+        }();
+
+        std::vector<uint8> const& bytes = templates[hidden ? 1 : 0];
+        uint64 const guid = receiver->GetGUID().GetRawValue();
+
+        WorldPacket& pkt = GetAddonReplyPool().packet;
+        pkt.Initialize(SMSG_MESSAGECHAT, bytes.size());
+        pkt.append(bytes.data(), bytes.size());
+        pkt.put<uint64>(ADDON_WHISPER_SENDER_GUID_POS, guid);
+        pkt.put<uint64>(ADDON_WHISPER_RECEIVER_GUID_POS, guid);
+        receiver->SendDirectMessage(&pkt);
     }
 
     static std::string ToLowerAscii(std::string value)
@@ -231,6 +338,18 @@ namespace
 
         return "bot";
     }
+
+    static uint8 GetSnapshotKind(Player* target)
+    {
+        std::string const token = GetPlayerKindToken(target);
+        if (token == "rndbot")
+            return RTG::ParagonSnapshot::KIND_RNDBOT;
+        if (token == "addclassbot")
+            return RTG::ParagonSnapshot::KIND_ADDCLASSBOT;
+        if (token == "bot")
+            return RTG::ParagonSnapshot::KIND_BOT;
+        return RTG::ParagonSnapshot::KIND_REAL;
+    }
 }
 
 
@@ -243,9 +362,13 @@ public:
                 PLAYERHOOK_ON_GET_XP_FOR_LEVEL,
                 PLAYERHOOK_ON_LEVEL_CHANGED,
                 PLAYERHOOK_ON_CAN_GIVE_LEVEL,
+                PLAYERHOOK_ON_LOGIN,
+                PLAYERHOOK_ON_BEFORE_LOGOUT,
+                PLAYERHOOK_ON_LOGOUT,
+                PLAYERHOOK_ON_DELETE,
 				PLAYERHOOK_ON_BEFORE_SEND_CHAT_MESSAGE
             })
-        , WorldScript("ParagonLevels_WorldScript", { WORLDHOOK_ON_AFTER_CONFIG_LOAD })
+        , WorldScript("ParagonLevels_WorldScript", { WORLDHOOK_ON_AFTER_CONFIG_LOAD, WORLDHOOK_ON_STARTUP, WORLDHOOK_ON_SHUTDOWN, WORLDHOOK_ON_UPDATE })
     {
         s_instance = this;
     }
@@ -263,24 +386,40 @@ public:
 		if (type != CHAT_MSG_WHISPER || lang != LANG_ADDON)
 			return;
 
-		// msg is "PREFIX\tPAYLOAD"
-		auto parts = SplitTab(msg);
-		if (parts.size() < 2)
+		// msg is "PREFIX\tPAYLOAD"; views into msg, so only valid until msg.clear()
+		std::string_view const full(msg);
+		size_t const tab = full.find('\t');
+		if (tab == std::string_view::npos)
 			return;
 
-		std::string const& prefix  = parts[0];
-		std::string const& payload = parts[1];
+		std::string_view const prefix  = full.substr(0, tab);
+		std::string_view const payload = full.substr(tab + 1, full.find('\t', tab + 1) - (tab + 1));
 
-		if (prefix != "RTG_PARAGON")
+		if (prefix != RTG_PARAGON_ADDON_PREFIX)
 			return;
 
+		// Payload: "G?" asks for the player's guild paragon standings.
+		//   reply "G:<members>:<total>:<average>:<max>:<at50>:<at100>:<at150>:<at200>", or "G:0" without a guild
+		if (payload == "G?")
+		{
+			RTG::ParagonGuild::Summary summary;
+			if (GetGuildStandings(player, summary))
+			{
+				SendAddonReply(player, "G:{}:{}:{:.1f}:{}:{}:{}:{}:{}",
+					summary.members, summary.total, summary.Average(), summary.max,
+					summary.atMilestone[0], summary.atMilestone[1], summary.atMilestone[2], summary.atMilestone[3]);
+			}
+			else
+				SendAddonReply(player, "G:0");
+
+			msg.clear();
+			return;
+		}
+
 		// Payload: "W?" asks for the player's server-side /who bot visibility setting.
 		if (payload == "W?")
 		{
-			bool hidden = IsWhoBotsHidden(player);
-			std::string reply = fmt::format("W:{}", hidden ? 1 : 0);
-			WorldPacket pkt = CreateAddonWhisperPacket(prefix, reply, player);
-			player->SendDirectMessage(&pkt);
+			SendWhoBotsReply(player, IsWhoBotsHidden(player));
 			msg.clear();
 			return;
 		}
@@ -291,9 +430,7 @@ public:
 			bool hidden = payload == "W:1";
 			SetWhoBotsHidden(player, hidden);
 
-			std::string reply = fmt::format("W:{}", hidden ? 1 : 0);
-			WorldPacket pkt = CreateAddonWhisperPacket(prefix, reply, player);
-			player->SendDirectMessage(&pkt);
+			SendWhoBotsReply(player, hidden);
 			msg.clear();
 			return;
 		}
@@ -305,21 +442,17 @@ public:
 			return;
 		}
 
-		std::string qName = payload.substr(2);
+		std::string qName(payload.substr(2));
 
 		Player* target = ObjectAccessor::FindPlayerByName(qName);
 		uint32 paragon = target ? GetParagonLevel(target) : 0;
-		std::string kind = GetPlayerKindToken(target);
+		std::string kind = GetIndexedKindToken(target);
 
 		// Keep the old A: reply for any older installed RTG_ParagonDisplay clients,
 		// then send B: with the extra real-player/playerbot/rndbot metadata.
-		std::string legacyReply = fmt::format("A:{}:{}", qName, paragon);
-		WorldPacket legacyPkt = CreateAddonWhisperPacket(prefix, legacyReply, player);
-		player->SendDirectMessage(&legacyPkt);
-
-		std::string reply = fmt::format("B:{}:{}:{}", qName, paragon, kind);
-		WorldPacket pkt = CreateAddonWhisperPacket(prefix, reply, player);
-		player->SendDirectMessage(&pkt);
+		// Both are serialized into the same pooled buffer, one after the other.
+		SendAddonReply(player, "A:{}:{}", qName, paragon);
+		SendAddonReply(player, "B:{}:{}:{}", qName, paragon, kind);
 
 		// prevent further processing of this addon whisper
 		msg.clear();
@@ -328,17 +461,28 @@ public:
     void OnAfterConfigLoad(bool /*reload*/) override
     {
         EnsureParagonSettingsSchema();
+        RTG::ParagonGuild::Standings::EnsureSchema();
 
         isEnabled = sConfigMgr->GetOption<bool>("ParagonLevel.Enable", true);
         m_xpPerLevelMod = sConfigMgr->GetOption<float>("ParagonLevel.XpPerLevelMod", 2.0f);
         m_maxParagonLevel = sConfigMgr->GetOption<uint32>("ParagonLevel.MaxParagonLevel", 200);
         defaultMaxLevel = sConfigMgr->GetOption<int32>("MaxPlayerLevel", DEFAULT_MAX_LEVEL);
+        m_levelUpSpell = sConfigMgr->GetOption<uint32>("ParagonLevel.LevelUpSpell", 47292);
+        m_restoreStatsOnLevelUp = sConfigMgr->GetOption<bool>("ParagonLevel.RestoreStatsOnLevelUp", false);
+        m_dispatchBudgetMs = sConfigMgr->GetOption<uint32>("ParagonLevel.Dispatch.BudgetMs", 2);
+        m_guildFlushIntervalMs = sConfigMgr->GetOption<uint32>("ParagonLevel.GuildSummary.FlushInterval", 60) * IN_MILLISECONDS;
+
+        // Snapshot file is opened once at startup; changing these needs a restart.
+        if (!m_snapshot.IsOpen())
+        {
+            m_snapshotPath = sConfigMgr->GetOption<std::string>("ParagonLevel.Snapshot.Path", "");
+            m_snapshotCapacity = sConfigMgr->GetOption<uint32>("ParagonLevel.Snapshot.Capacity", 65536);
+        }
 
-        // Milestone titles
-        m_titleAt50  = sConfigMgr->GetOption<uint32>("ParagonLevel.TitleAt50",  0);
-        m_titleAt100 = sConfigMgr->GetOption<uint32>("ParagonLevel.TitleAt100", 0);
-        m_titleAt150 = sConfigMgr->GetOption<uint32>("ParagonLevel.TitleAt150", 0);
-        m_titleAt200 = sConfigMgr->GetOption<uint32>("ParagonLevel.TitleAt200", 0);
+        // Milestone titles (ParagonLevel.TitleAt50 / 100 / 150 / 200)
+        for (size_t i = 0; i < RTG::ParagonCurve::TITLE_MILESTONE_COUNT; ++i)
+            m_milestoneTitles[i] = sConfigMgr->GetOption<uint32>(
+                fmt::format("ParagonLevel.TitleAt{}", RTG::ParagonCurve::TITLE_MILESTONES[i]), 0);
 
         // Paragon tier chat color strings (used in *Paragon system messages* only)
         m_colorTier0 = sConfigMgr->GetOption<std::string>("ParagonLevel.ChatColor.Tier0", "|cffFFFFFF"); // 1-49
@@ -348,6 +492,9 @@ public:
         m_colorTier4 = sConfigMgr->GetOption<std::string>("ParagonLevel.ChatColor.Tier4", "|cffFF8000"); // 200
         m_chatColorDefaultEnabled = sConfigMgr->GetOption<bool>("ParagonLevel.ChatColor.DefaultEnabled", true);
 
+        m_statBonusEnabled = sConfigMgr->GetOption<bool>("ParagonLevel.StatBonus.Enable", true);
+        LoadStatBonuses();
+
         if (isEnabled)
         {
             // Allow one extra level-up past max level to trigger our paragon hook logic
@@ -361,6 +508,81 @@ public:
         }
     }
 
+    void OnStartup() override
+    {
+        LoadSnapshot();
+        m_guildStandings.Load();
+        m_guildStandings.Flush(m_guildFlushIntervalMs);
+    }
+
+    void OnShutdown() override
+    {
+        m_snapshot.Close();
+        // Guilds still waiting on a rebuild are rescanned by Load() on the next startup.
+        m_guildStandings.Flush(m_guildFlushIntervalMs);
+    }
+
+    // ------------------------------- scoreboard snapshot -------------------------------
+
+    void LoadSnapshot()
+    {
+        if (m_snapshotPath.empty() || !m_snapshot.Open(m_snapshotPath, m_snapshotCapacity))
+            return;
+
+        // One scan seeds every character; afterwards only level-ups, logins, logouts and
+        // deletions touch the file.
+        QueryResult result = CharacterDatabase.Query(
+            "SELECT c.guid, c.name, COALESCE(cc.ParagonLevel, 0) FROM characters c "
+            "LEFT JOIN character_currencies cc ON cc.guid = c.guid "
+            "WHERE c.deleteInfos_Account IS NULL");
+        if (!result)
+            return;
+
+        uint32 count = 0;
+        do
+        {
+            Field* fields = result->Fetch();
+            m_snapshot.Publish(fields[0].Get<uint32>(), fields[1].Get<std::string>(), fields[2].Get<uint32>(),
+                RTG::ParagonSnapshot::KIND_UNKNOWN, false);
+            ++count;
+        } while (result->NextRow());
+
+        LOG_INFO("module", "ParagonSnapshot: seeded {} characters.", count);
+    }
+
+    void OnPlayerLogin(Player* player) override
+    {
+        if (!player)
+            return;
+
+        uint32 const paragonLevel = GetParagonLevel(player);
+        uint8 const kind = GetSnapshotKind(player);
+
+        SyncStatBonus(player, paragonLevel);
+        IndexOnlinePlayer(player, paragonLevel, kind);
+
+        if (m_snapshot.IsOpen())
+            m_snapshot.Publish(player->GetGUID().GetCounter(), player->GetName(), paragonLevel, kind, true);
+    }
+
+    void OnPlayerDelete(ObjectGuid guid, uint32 /*accountId*/) override
+    {
+        m_snapshot.Remove(guid.GetCounter());
+        m_guildStandings.RemoveMember(guid.GetCounter());
+    }
+
+    // ------------------------------- guild standings -------------------------------
+
+    RTG::ParagonGuild::Standings& GetGuildStandingsTracker() { return m_guildStandings; }
+
+    bool GetGuildStandings(Player* player, RTG::ParagonGuild::Summary& out) const
+    {
+        if (!player || !player->GetGuildId())
+            return false;
+
+        return m_guildStandings.Get(player->GetGuildId(), out);
+    }
+
     // ------------------------------- currency integration -------------------------------
 
     static uint32 GetParagonLevel(Player* player)
@@ -393,17 +615,9 @@ public:
         if (!player)
             return 0;
 
-        if (paragonLevel >= m_maxParagonLevel)
-        {
-            // Make next level unreachable at cap (prevents spam/loops)
-            return std::numeric_limits<uint32>::max();
-        }
-
-        if (m_xpPerLevelMod <= 1.0f)
-            return sObjectMgr->GetXPForLevel(player->GetLevel());
-
-        float mod = 1.0f + ((paragonLevel * m_xpPerLevelMod) / 100.0f);
-        return static_cast<uint32>(sObjectMgr->GetXPForLevel(player->GetLevel()) * mod);
+        // Shared with tools/paragon_sim, see paragon_curve.h
+        return RTG::ParagonCurve::XpForNextLevel(sObjectMgr->GetXPForLevel(player->GetLevel()),
+            paragonLevel, m_xpPerLevelMod, m_maxParagonLevel);
     }
 
     // ------------------------------- level / xp hooks -------------------------------
@@ -437,58 +651,311 @@ public:
             return false;
         }
 
-        // Optional level up spell
-        if (const uint32 levelUpSpell = sConfigMgr->GetOption<uint32>("ParagonLevel.LevelUpSpell", 47292))
-            player->CastSpell(player, levelUpSpell, true);
-
         const uint32 paragonLevel = IncreaseParagonLevel(player);
+        SyncStatBonus(player, paragonLevel);
+        QueueLevelUp(player, currentParagon, paragonLevel);
+        m_snapshot.SetParagon(player->GetGUID().GetCounter(), paragonLevel);
+        m_guildStandings.SetParagon(player->GetGUID().GetCounter(), paragonLevel);
+        UpdateOnlineParagon(player, paragonLevel);
+
+        // Next XP requirement based on paragon level
+        player->SetUInt32Value(PLAYER_NEXT_LEVEL_XP, GetXpForNextLevel(player, paragonLevel));
+        return false;
+    }
+
+    void OnPlayerGetXpForLevel(Player* player, uint32& xp) override
+    {
+        if (!isEnabled || !player)
+            return;
+
+        const uint32 paragonLevel = GetParagonLevel(player);
+        if (paragonLevel == 0)
+            return;
+
+        xp = GetXpForNextLevel(player, paragonLevel);
+    }
+
+    // Runs before WorldSession::LogoutPlayer saves the character, so whatever is still
+    // queued is granted now and persisted by that save. Logout can happen out of world
+    // (e.g. disconnect during a far teleport); then only the map-independent parts run.
+    void OnPlayerBeforeLogout(Player* player) override
+    {
+        if (!player)
+            return;
+
+        PendingParagonLevelUp pending;
+        if (TakePendingLevelUp(player->GetGUID(), pending))
+            DispatchLevelUp(player, pending, player->IsInWorld());
+    }
+
+    void OnPlayerLogout(Player* player) override
+    {
+        if (!player)
+            return;
+
+        m_snapshot.SetOnline(player->GetGUID().GetCounter(), false);
+
+        {
+            std::unique_lock<std::shared_mutex> guard(m_onlineLock);
+            m_onlineIndex.erase(player->GetGUID().GetCounter());
+        }
+
+        // Stat modifiers die with the Player object, only the bookkeeping needs dropping.
+        {
+            std::lock_guard<std::mutex> guard(m_statLock);
+            m_appliedStatLevel.erase(player->GetGUID().GetCounter());
+        }
+    }
+
+    // ------------------------------- deferred level-up dispatch -------------------------------
+
+    void OnUpdate(uint32 diff) override
+    {
+        DrainPendingLevelUps();
+
+        m_guildFlushTimer += diff;
+        if (m_guildFlushTimer >= m_guildFlushIntervalMs)
+        {
+            m_guildFlushTimer = 0;
+            m_guildStandings.Flush(m_guildFlushIntervalMs);
+        }
+    }
+
+    void QueueLevelUp(Player* player, uint32 fromParagonLevel, uint32 toParagonLevel)
+    {
+        std::lock_guard<std::mutex> guard(m_pendingLock);
+
+        auto [itr, inserted] = m_pendingLevelUps.try_emplace(player->GetGUID());
+        PendingParagonLevelUp& pending = itr->second;
+        if (inserted)
+        {
+            pending.fromParagonLevel = fromParagonLevel;
+            m_pendingOrder.push_back(player->GetGUID());
+        }
+
+        pending.toParagonLevel = toParagonLevel;
+        ++pending.rewardCounts[PARAGON_REWARD_LEVEL_UP];
+        if (RTG::ParagonCurve::IsRewardInterval(toParagonLevel))
+            ++pending.rewardCounts[PARAGON_REWARD_LEVEL_UP_5_INTERVAL];
+    }
+
+    bool TakePendingLevelUp(ObjectGuid guid, PendingParagonLevelUp& out)
+    {
+        std::lock_guard<std::mutex> guard(m_pendingLock);
+
+        auto itr = m_pendingLevelUps.find(guid);
+        if (itr == m_pendingLevelUps.end())
+            return false;
+
+        out = itr->second;
+        m_pendingLevelUps.erase(itr);
+        // The matching m_pendingOrder slot is skipped lazily by the drain.
+        return true;
+    }
+
+    void DrainPendingLevelUps()
+    {
+        uint32 const startMs = getMSTime();
+
+        // Bounded by the queue length at entry so players that are not in world yet
+        // (loading, far teleport) are retried on a later tick instead of spinning here.
+        size_t remaining;
+        {
+            std::lock_guard<std::mutex> guard(m_pendingLock);
+            remaining = m_pendingOrder.size();
+        }
+
+        while (remaining--)
+        {
+            ObjectGuid guid;
+            {
+                std::lock_guard<std::mutex> guard(m_pendingLock);
+                if (m_pendingOrder.empty())
+                    return;
+
+                guid = m_pendingOrder.front();
+                m_pendingOrder.pop_front();
+            }
+
+            Player* player = ObjectAccessor::FindConnectedPlayer(guid);
+            if (player && !player->IsInWorld())
+            {
+                std::lock_guard<std::mutex> guard(m_pendingLock);
+                if (m_pendingLevelUps.count(guid))
+                    m_pendingOrder.push_back(guid);
+                continue;
+            }
+
+            PendingParagonLevelUp pending;
+            if (!TakePendingLevelUp(guid, pending) || !player)
+                continue;
+
+            DispatchLevelUp(player, pending, true);
+
+            if (m_dispatchBudgetMs && GetMSTimeDiffToNow(startMs) >= m_dispatchBudgetMs)
+                return;
+        }
+    }
+
+    // `inWorld` = false skips everything that needs a map: the visual spell, the chat
+    // feedback and the resource restore. Rewards, titles and telemetry are granted either
+    // way; they persist through the next character save, which is why the logout path
+    // dispatches from OnPlayerBeforeLogout rather than OnPlayerLogout.
+    void DispatchLevelUp(Player* player, PendingParagonLevelUp const& pending, bool inWorld)
+    {
+        // Optional level up spell (visual), once per batch
+        if (inWorld && m_levelUpSpell)
+            player->CastSpell(player, m_levelUpSpell, true);
 
         // Rewards
-        sRewardSystem->HandleRewards(player, "ON_PLAYER_LEVEL_UP_PARAGON");
-        if (paragonLevel % 5 == 0)
-            sRewardSystem->HandleRewards(player, "ON_PLAYER_LEVEL_UP_PARAGON_5_INTERVAL");
+        for (uint8 eventId = 0; eventId < MAX_PARAGON_REWARD_EVENTS; ++eventId)
+            for (uint32 i = 0; i < pending.rewardCounts[eventId]; ++i)
+                sRewardSystem->HandleRewards(player, ParagonRewardEventKeys[eventId]);
 
         // Feedback
-        const bool useColor = IsChatColorEnabled(player);
-        std::string tierColor = useColor ? GetTierColor(paragonLevel) : std::string("|cffFF0000");
-        ChatHandler(player->GetSession()).PSendSysMessage(
-            "|cff00FFFFYour Paragon Level is:|r {}{}|r",
-            tierColor, paragonLevel);
+        const uint32 paragonLevel = pending.toParagonLevel;
+        if (inWorld)
+        {
+            const bool useColor = IsChatColorEnabled(player);
+            std::string tierColor = useColor ? GetTierColor(paragonLevel) : std::string("|cffFF0000");
+            ChatHandler(player->GetSession()).PSendSysMessage(
+                "|cff00FFFFYour Paragon Level is:|r {}{}|r",
+                tierColor, paragonLevel);
+        }
 
-        // Titles at milestones
-        HandleMilestoneRewards(player, paragonLevel);
-        PublishTelemetryMilestone(player, paragonLevel);
+        // Titles and telemetry for every milestone crossed by this batch
+        for (uint32 level = pending.fromParagonLevel + 1; level <= paragonLevel; ++level)
+        {
+            HandleMilestoneRewards(player, level);
+            PublishTelemetryMilestone(player, level);
+        }
 
         // Restore resources (optional)
-        if (sConfigMgr->GetOption<bool>("ParagonLevel.RestoreStatsOnLevelUp", false))
+        if (inWorld && m_restoreStatsOnLevelUp && !player->isDead())
+        {
+            player->SetFullHealth();
+            player->SetPower(POWER_MANA, player->GetMaxPower(POWER_MANA));
+            player->SetPower(POWER_ENERGY, player->GetMaxPower(POWER_ENERGY));
+            if (player->GetPower(POWER_RAGE) > player->GetMaxPower(POWER_RAGE))
+                player->SetPower(POWER_RAGE, player->GetMaxPower(POWER_RAGE));
+            player->SetPower(POWER_FOCUS, 0);
+            player->SetPower(POWER_HAPPINESS, 0);
+        }
+    }
+
+    // ------------------------------- stat bonuses -------------------------------
+
+    // Rebuilds the prefix sums. Players already holding bonuses are moved from the old
+    // totals to the new ones so a reload never double-applies. With the module or the
+    // stat bonuses disabled the new totals are all zero, which strips every applied bonus.
+    void LoadStatBonuses()
+    {
+        std::vector<ParagonStatTotals> totals(1, ParagonStatTotals{ });
+
+        if (isEnabled && m_statBonusEnabled)
         {
-            if (!player->isDead())
+            if (QueryResult result = WorldDatabase.Query("SELECT level, stat, value FROM paragon_level_stat_bonus"))
             {
-                player->SetFullHealth();
-                player->SetPower(POWER_MANA, player->GetMaxPower(POWER_MANA));
-                player->SetPower(POWER_ENERGY, player->GetMaxPower(POWER_ENERGY));
-                if (player->GetPower(POWER_RAGE) > player->GetMaxPower(POWER_RAGE))
-                    player->SetPower(POWER_RAGE, player->GetMaxPower(POWER_RAGE));
-                player->SetPower(POWER_FOCUS, 0);
-                player->SetPower(POWER_HAPPINESS, 0);
+                do
+                {
+                    Field* fields = result->Fetch();
+                    uint32 level = fields[0].Get<uint32>();
+                    uint8 stat = fields[1].Get<uint8>();
+                    int32 value = fields[2].Get<int32>();
+
+                    // totals[0] is the "nothing applied yet" baseline and must stay empty.
+                    if (stat >= MAX_PARAGON_STAT_BONUSES || level < 1 || level > m_maxParagonLevel)
+                    {
+                        LOG_ERROR("sql.sql", "Table `paragon_level_stat_bonus` has invalid row (level {}, stat {}), skipped.", level, stat);
+                        continue;
+                    }
+
+                    if (totals.size() <= level)
+                        totals.resize(level + 1, ParagonStatTotals{ });
+
+                    totals[level][stat] += value;
+                } while (result->NextRow());
             }
+
+            for (size_t level = 1; level < totals.size(); ++level)
+                for (uint8 stat = 0; stat < MAX_PARAGON_STAT_BONUSES; ++stat)
+                    totals[level][stat] += totals[level - 1][stat];
         }
 
-        // Next XP requirement based on paragon level
-        player->SetUInt32Value(PLAYER_NEXT_LEVEL_XP, GetXpForNextLevel(player, paragonLevel));
-        return false;
+        std::lock_guard<std::mutex> guard(m_statLock);
+        for (auto const& [guidLow, level] : m_appliedStatLevel)
+        {
+            Player* player = ObjectAccessor::FindConnectedPlayer(ObjectGuid::Create<HighGuid::Player>(guidLow));
+            if (!player)
+                continue;
+
+            ParagonStatTotals const& from = LookupStatTotals(m_statTotals, level);
+            ParagonStatTotals const& to = LookupStatTotals(totals, level);
+            ApplyStatDelta(player, from, to);
+        }
+
+        m_statTotals = std::move(totals);
     }
 
-    void OnPlayerGetXpForLevel(Player* player, uint32& xp) override
+    static ParagonStatTotals const& LookupStatTotals(std::vector<ParagonStatTotals> const& totals, uint32 level)
     {
-        if (!isEnabled || !player)
+        static ParagonStatTotals const none = { };
+        if (totals.empty())
+            return none;
+
+        return totals[std::min<size_t>(level, totals.size() - 1)];
+    }
+
+    // Moves a player's stat bonus to the totals of `paragonLevel`, touching only what changed.
+    void SyncStatBonus(Player* player, uint32 paragonLevel)
+    {
+        if (!isEnabled || !m_statBonusEnabled)
             return;
 
-        const uint32 paragonLevel = GetParagonLevel(player);
-        if (paragonLevel == 0)
+        if (player->GetSession() && player->GetSession()->IsBot())
             return;
 
-        xp = GetXpForNextLevel(player, paragonLevel);
+        std::lock_guard<std::mutex> guard(m_statLock);
+
+        uint32 const guidLow = player->GetGUID().GetCounter();
+        auto itr = m_appliedStatLevel.find(guidLow);
+        uint32 const appliedLevel = itr != m_appliedStatLevel.end() ? itr->second : 0;
+        if (itr != m_appliedStatLevel.end() && appliedLevel == paragonLevel)
+            return;
+
+        ApplyStatDelta(player, LookupStatTotals(m_statTotals, appliedLevel), LookupStatTotals(m_statTotals, paragonLevel));
+        m_appliedStatLevel[guidLow] = paragonLevel;
+    }
+
+    static void ApplyStatDelta(Player* player, ParagonStatTotals const& from, ParagonStatTotals const& to)
+    {
+        for (uint8 stat = 0; stat < MAX_PARAGON_STAT_BONUSES; ++stat)
+        {
+            int32 const delta = to[stat] - from[stat];
+            if (!delta)
+                continue;
+
+            bool const apply = delta > 0;
+            float const amount = float(apply ? delta : -delta);
+
+            switch (stat)
+            {
+                case PARAGON_STAT_STAMINA:   player->HandleStatModifier(UNIT_MOD_STAT_STAMINA, TOTAL_VALUE, amount, apply); break;
+                case PARAGON_STAT_STRENGTH:  player->HandleStatModifier(UNIT_MOD_STAT_STRENGTH, TOTAL_VALUE, amount, apply); break;
+                case PARAGON_STAT_AGILITY:   player->HandleStatModifier(UNIT_MOD_STAT_AGILITY, TOTAL_VALUE, amount, apply); break;
+                case PARAGON_STAT_INTELLECT: player->HandleStatModifier(UNIT_MOD_STAT_INTELLECT, TOTAL_VALUE, amount, apply); break;
+                case PARAGON_STAT_SPIRIT:    player->HandleStatModifier(UNIT_MOD_STAT_SPIRIT, TOTAL_VALUE, amount, apply); break;
+                case PARAGON_STAT_ATTACK_POWER:
+                    player->HandleStatModifier(UNIT_MOD_ATTACK_POWER, TOTAL_VALUE, amount, apply);
+                    player->HandleStatModifier(UNIT_MOD_ATTACK_POWER_RANGED, TOTAL_VALUE, amount, apply);
+                    break;
+                case PARAGON_STAT_SPELL_POWER: player->ApplySpellPowerBonus(int32(amount), apply); break;
+                case PARAGON_STAT_ARMOR:       player->HandleStatModifier(UNIT_MOD_ARMOR, TOTAL_VALUE, amount, apply); break;
+                case PARAGON_STAT_HEALTH:      player->HandleStatModifier(UNIT_MOD_HEALTH, TOTAL_VALUE, amount, apply); break;
+                default:
+                    break;
+            }
+        }
     }
 
     // ------------------------------- toggles (per character) -------------------------------
@@ -529,6 +996,73 @@ public:
         uint32 guidLow = player->GetGUID().GetCounter();
         m_cachedWhoBotsHidden[guidLow] = hidden;
         SaveWhoBotsHidden(guidLow, hidden);
+
+        std::unique_lock<std::shared_mutex> guard(m_onlineLock);
+        auto itr = m_onlineIndex.find(guidLow);
+        if (itr != m_onlineIndex.end())
+            itr->second.hideWhoBots = hidden;
+    }
+
+    // ------------------------------- online index (/who) -------------------------------
+
+    struct OnlineEntry
+    {
+        uint32 paragon = 0;
+        uint8 kind = RTG::ParagonSnapshot::KIND_REAL;
+        bool hideWhoBots = false;
+    };
+
+    static uint8 KindMask(uint8 kind)
+    {
+        switch (kind)
+        {
+            case RTG::ParagonSnapshot::KIND_RNDBOT:      return RTG::ParagonWho::KIND_MASK_RNDBOT;
+            case RTG::ParagonSnapshot::KIND_ADDCLASSBOT: return RTG::ParagonWho::KIND_MASK_ADDCLASSBOT;
+            case RTG::ParagonSnapshot::KIND_BOT:         return RTG::ParagonWho::KIND_MASK_BOT;
+            default:                                     return RTG::ParagonWho::KIND_MASK_REAL;
+        }
+    }
+
+    // Everything the /who predicates need is resolved here, once per login, including the
+    // account lookup behind GetPlayerKindToken and the hide_who_bots preference.
+    void IndexOnlinePlayer(Player* player, uint32 paragonLevel, uint8 kind)
+    {
+        OnlineEntry entry;
+        entry.paragon = paragonLevel;
+        entry.kind = kind;
+        // Bots never run /who themselves; skip their preference lookup.
+        entry.hideWhoBots = player->GetSession() && !player->GetSession()->IsBot() && IsWhoBotsHidden(player);
+
+        std::unique_lock<std::shared_mutex> guard(m_onlineLock);
+        m_onlineIndex[player->GetGUID().GetCounter()] = entry;
+    }
+
+    void UpdateOnlineParagon(Player* player, uint32 paragonLevel)
+    {
+        std::unique_lock<std::shared_mutex> guard(m_onlineLock);
+        auto itr = m_onlineIndex.find(player->GetGUID().GetCounter());
+        if (itr != m_onlineIndex.end())
+            itr->second.paragon = paragonLevel;
+    }
+
+    bool FindOnline(ObjectGuid guid, OnlineEntry& out) const
+    {
+        std::shared_lock<std::shared_mutex> guard(m_onlineLock);
+        auto itr = m_onlineIndex.find(guid.GetCounter());
+        if (itr == m_onlineIndex.end())
+            return false;
+
+        out = itr->second;
+        return true;
+    }
+
+    std::string GetIndexedKindToken(Player* target) const
+    {
+        OnlineEntry entry;
+        if (target && FindOnline(target->GetGUID(), entry))
+            return RTG::ParagonSnapshot::KindToken(entry.kind);
+
+        return GetPlayerKindToken(target);
     }
 
     std::string GetTierColor(uint32 paragonLevel) const
@@ -544,27 +1078,9 @@ public:
         return m_colorTier0;
     }
 
-    static bool IsTelemetryMilestone(uint32 paragonLevel)
-    {
-        switch (paragonLevel)
-        {
-            case 25:
-            case 50:
-            case 75:
-            case 100:
-            case 125:
-            case 150:
-            case 175:
-            case 200:
-                return true;
-            default:
-                return false;
-        }
-    }
-
     static void PublishTelemetryMilestone(Player* player, uint32 paragonLevel)
     {
-        if (!player || !IsTelemetryMilestone(paragonLevel))
+        if (!player || !RTG::ParagonCurve::IsTelemetryMilestone(paragonLevel))
             return;
 
         RTG::ScoreboardTelemetrySink::LogEvent(
@@ -578,12 +1094,11 @@ public:
 
     void HandleMilestoneRewards(Player* player, uint32 paragonLevel)
     {
-        uint32 titleId = 0;
-        if (paragonLevel == 50)  titleId = m_titleAt50;
-        if (paragonLevel == 100) titleId = m_titleAt100;
-        if (paragonLevel == 150) titleId = m_titleAt150;
-        if (paragonLevel == 200) titleId = m_titleAt200;
+        size_t const milestone = RTG::ParagonCurve::TitleMilestoneIndex(paragonLevel);
+        if (milestone >= RTG::ParagonCurve::TITLE_MILESTONE_COUNT)
+            return;
 
+        uint32 const titleId = m_milestoneTitles[milestone];
         if (!titleId)
             return;
 
@@ -610,11 +1125,37 @@ private:
 
     uint32 m_maxParagonLevel = 200;
 
+    uint32 m_levelUpSpell = 47292;
+    bool m_restoreStatsOnLevelUp = false;
+
+    // Deferred level-up side effects (filled from map threads, drained by the world thread)
+    uint32 m_dispatchBudgetMs = 2;
+    std::mutex m_pendingLock;
+    std::unordered_map<ObjectGuid, PendingParagonLevelUp> m_pendingLevelUps;
+    std::deque<ObjectGuid> m_pendingOrder;
+
+    // External scoreboard snapshot
+    std::string m_snapshotPath;
+    uint32 m_snapshotCapacity = 65536;
+    RTG::ParagonSnapshot::Writer m_snapshot;
+
+    // Guild standings, flushed to character_paragon_guild_summary every m_guildFlushIntervalMs
+    RTG::ParagonGuild::Standings m_guildStandings;
+    uint32 m_guildFlushIntervalMs = 60 * IN_MILLISECONDS;
+    uint32 m_guildFlushTimer = 0;
+
+    // Online player index for the /who predicates (guidLow -> entry)
+    mutable std::shared_mutex m_onlineLock;
+    std::unordered_map<uint32, OnlineEntry> m_onlineIndex;
+
+    // Stat bonuses: m_statTotals[level] = prefix sum of paragon_level_stat_bonus up to level
+    bool m_statBonusEnabled = true;
+    std::mutex m_statLock;
+    std::vector<ParagonStatTotals> m_statTotals;
+    std::unordered_map<uint32, uint32> m_appliedStatLevel; // guidLow -> paragon level whose totals are applied
+
     // Milestone title IDs
-    uint32 m_titleAt50  = 0;
-    uint32 m_titleAt100 = 0;
-    uint32 m_titleAt150 = 0;
-    uint32 m_titleAt200 = 0;
+    std::array<uint32, RTG::ParagonCurve::TITLE_MILESTONE_COUNT> m_milestoneTitles = { }; // by TITLE_MILESTONES index
 
     // Tier color strings (server-side chat color formatting)
     std::string m_colorTier0;
@@ -632,6 +1173,51 @@ private:
 
 ParagonLevels* ParagonLevels::s_instance = nullptr;
 
+// --------------------------------- guild hooks ---------------------------------
+
+class ParagonLevelsGuild : public GuildScript
+{
+public:
+    ParagonLevelsGuild()
+        : GuildScript("ParagonLevels_GuildScript",
+            {
+                GUILDHOOK_ON_ADD_MEMBER,
+                GUILDHOOK_ON_REMOVE_MEMBER,
+                GUILDHOOK_ON_DISBAND
+            })
+    { }
+
+    void OnAddMember(Guild* guild, Player* player, uint8& /*plRank*/) override
+    {
+        auto* mod = ParagonLevels::Get();
+        if (!mod || !guild)
+            return;
+
+        if (player)
+            mod->GetGuildStandingsTracker().AddMember(guild->GetId(), player->GetGUID().GetCounter(), ParagonLevels::GetParagonLevel(player));
+        else
+            mod->GetGuildStandingsTracker().RequestRebuild(guild->GetId());
+    }
+
+    void OnRemoveMember(Guild* guild, Player* player, bool isDisbanding, bool /*isKicked*/) override
+    {
+        auto* mod = ParagonLevels::Get();
+        if (!mod || !guild || isDisbanding)
+            return;
+
+        if (player)
+            mod->GetGuildStandingsTracker().RemoveMember(player->GetGUID().GetCounter());
+        else
+            mod->GetGuildStandingsTracker().RequestRebuild(guild->GetId());
+    }
+
+    void OnDisband(Guild* guild) override
+    {
+        if (auto* mod = ParagonLevels::Get(); mod && guild)
+            mod->GetGuildStandingsTracker().Disband(guild->GetId());
+    }
+};
+
 // --------------------------------- commands ---------------------------------
 
 class ParagonLevelsCommands : public CommandScript
@@ -687,6 +1273,33 @@ public:
         return true;
     }
 
+    static bool HandleParagonGuild(ChatHandler* handler)
+    {
+        Player* player = handler->GetPlayer();
+        if (!player)
+            return false;
+
+        auto* mod = ParagonLevels::Get();
+        if (!mod)
+        {
+            handler->SendSysMessage("Paragon module not loaded.");
+            return true;
+        }
+
+        RTG::ParagonGuild::Summary summary;
+        if (!mod->GetGuildStandings(player, summary))
+        {
+            handler->SendSysMessage("|cffff0000You are not in a guild.|r");
+            return true;
+        }
+
+        handler->PSendSysMessage("|cff00FFFFGuild Paragon:|r {} members, total {}, average {:.1f}, highest {}",
+            summary.members, summary.total, summary.Average(), summary.max);
+        handler->PSendSysMessage("|cff00FFFFMilestones:|r 50+: {}  100+: {}  150+: {}  200+: {}",
+            summary.atMilestone[0], summary.atMilestone[1], summary.atMilestone[2], summary.atMilestone[3]);
+        return true;
+    }
+
     Acore::ChatCommands::ChatCommandTable GetCommands() const override
     {
         using namespace Acore::ChatCommands;
@@ -701,6 +1314,7 @@ public:
         static ChatCommandTable paragonRoot =
         {
             ChatCommandBuilder("color", paragonColorSub),
+            ChatCommandBuilder("guild", HandleParagonGuild, SEC_PLAYER, Console::No),
         };
 
         static ChatCommandTable commands =
@@ -715,5 +1329,119 @@ public:
 void Add_ParagonLevels()
 {
     new ParagonLevels();
+    new ParagonLevelsGuild();
     new ParagonLevelsCommands();
-}
\ No newline at end of file
+}
+
+// --------------------------------- /who predicates ---------------------------------
+
+namespace RTG::ParagonWho
+{
+    bool ParseFilterToken(std::string const& word, Filter& filter)
+    {
+        std::string const lower = ToLowerAscii(word);
+        size_t const colon = lower.find(':');
+        if (colon == std::string::npos)
+            return false;
+
+        std::string const key = lower.substr(0, colon);
+        std::string const value = lower.substr(colon + 1);
+        if (value.empty())
+            return false;
+
+        if (key == "kind")
+        {
+            uint8 mask = 0;
+            if (value == "real" || value == "player")
+                mask = KIND_MASK_REAL;
+            else if (value == "bot" || value == "bots")
+                mask = KIND_MASK_ANY_BOT;
+            else if (value == "rndbot")
+                mask = KIND_MASK_RNDBOT;
+            else if (value == "addclassbot")
+                mask = KIND_MASK_ADDCLASSBOT;
+            else
+                return false;
+
+            // First kind token narrows from "all", later ones widen the selection.
+            filter.kinds = filter.kinds == KIND_MASK_ALL ? mask : uint8(filter.kinds | mask);
+            return true;
+        }
+
+        if (key != "p" && key != "paragon")
+            return false;
+
+        auto parseNumber = [](std::string const& text, uint32& out) -> bool
+        {
+            if (text.empty() || text.size() > 9 || !std::all_of(text.begin(), text.end(), [](unsigned char c) { return std::isdigit(c) != 0; }))
+                return false;
+            out = uint32(std::stoul(text));
+            return true;
+        };
+
+        uint32 minParagon = 0;
+        uint32 maxParagon = std::numeric_limits<uint32>::max();
+
+        if (value.back() == '+')
+        {
+            if (!parseNumber(value.substr(0, value.size() - 1), minParagon))
+                return false;
+        }
+        else if (size_t const dash = value.find('-'); dash != std::string::npos)
+        {
+            std::string const low = value.substr(0, dash);
+            std::string const high = value.substr(dash + 1);
+            if ((!low.empty() && !parseNumber(low, minParagon)) || !parseNumber(high, maxParagon))
+                return false;
+        }
+        else
+        {
+            if (!parseNumber(value, minParagon))
+                return false;
+            maxParagon = minParagon;
+        }
+
+        if (minParagon > maxParagon)
+            std::swap(minParagon, maxParagon);
+
+        filter.minParagon = minParagon;
+        filter.maxParagon = maxParagon;
+        return true;
+    }
+
+    bool IsBotSession(WorldSession const* session)
+    {
+        return session && session->IsBot();
+    }
+
+    bool ShouldHideFromWho(ObjectGuid viewer, ObjectGuid target)
+    {
+        ParagonLevels* mod = ParagonLevels::Get();
+        ParagonLevels::OnlineEntry viewerEntry;
+        if (!mod || !mod->FindOnline(viewer, viewerEntry) || !viewerEntry.hideWhoBots)
+            return false;
+
+        ParagonLevels::OnlineEntry targetEntry;
+        return mod->FindOnline(target, targetEntry) && (ParagonLevels::KindMask(targetEntry.kind) & KIND_MASK_ANY_BOT);
+    }
+
+    bool MatchesFilter(ObjectGuid target, Filter const& filter)
+    {
+        if (!filter.IsActive())
+            return true;
+
+        ParagonLevels* mod = ParagonLevels::Get();
+        ParagonLevels::OnlineEntry entry;
+        if (!mod || !mod->FindOnline(target, entry))
+            return false;
+
+        return entry.paragon >= filter.minParagon
+            && entry.paragon <= filter.maxParagon
+            && (ParagonLevels::KindMask(entry.kind) & filter.kinds);
+    }
+
+    bool AcceptWhoRow(ObjectGuid viewer, ObjectGuid target, Filter const& filter)
+    {
+        return !ShouldHideFromWho(viewer, target) && MatchesFilter(target, filter);
+    }
+}
@@ -0,0 +1,102 @@
+#ifndef RTG_PARAGON_SNAPSHOT_FORMAT_H
+#define RTG_PARAGON_SNAPSHOT_FORMAT_H
+
+// Fixed on-disk layout of the memory-mapped paragon snapshot.
+//
+// Shared verbatim by the worldserver writer (paragon_snapshot_writer.h) and by the
+// external reader library / CLI in tools/paragon_snapshot, so it must stay free of
+// AzerothCore headers.
+//
+// File = Header, followed by Header::capacity Records.
+//
+// Consistency: one writer, any number of readers, no locks across processes.
+//  - Every Record carries its own sequence counter (seqlock). The writer makes it odd,
+//    writes the fields, then makes it even again. A reader copies the record and
+//    accepts the copy only if the counter was even and unchanged across the copy.
+//  - The per-level histogram (used to derive rank) is guarded the same way by
+//    Header::histogramSeq.
+//  - Rank is not stored per record: one level-up would otherwise rewrite every record
+//    tied at the old level. rank = 1 + number of characters with a higher paragon level.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace RTG::ParagonSnapshot
+{
+    static constexpr uint32_t MAGIC            = 0x50475452; // "RTGP"
+    static constexpr uint32_t LAYOUT_VERSION   = 1;
+    // 47 bytes + NUL: any 12 character name of up to 3 UTF-8 bytes per character fits; longer
+    // names (4-byte characters) are cut by the writer on a character boundary.
+    static constexpr uint32_t NAME_SIZE        = 48;
+    static constexpr uint32_t HISTOGRAM_LEVELS = 1024;       // levels >= 1023 share the last bucket
+
+    enum Kind : uint8_t
+    {
+        KIND_UNKNOWN     = 0, // offline character, kind not observed since startup
+        KIND_REAL        = 1,
+        KIND_RNDBOT      = 2,
+        KIND_ADDCLASSBOT = 3,
+        KIND_BOT         = 4,
+    };
+
+    enum State : uint32_t
+    {
+        STATE_LIVE    = 0,
+        STATE_RETIRED = 1, // writer has moved to a new file; readers should reopen the path
+    };
+
+    struct Header
+    {
+        uint32_t magic;              // written last during initialisation
+        uint32_t layoutVersion;
+        uint32_t headerSize;
+        uint32_t recordSize;
+        uint32_t capacity;
+        std::atomic<uint32_t> state;
+        std::atomic<uint32_t> recordCount;   // slots ever handed out; slots past this are unused
+        std::atomic<uint32_t> histogramSeq;
+        std::atomic<uint64_t> generation;    // bumped after every published change
+        std::atomic<uint32_t> levelCounts[HISTOGRAM_LEVELS];
+    };
+
+    struct Record
+    {
+        std::atomic<uint32_t> seq;
+        uint32_t guid;               // 0 = free slot
+        uint32_t paragon;
+        uint8_t kind;                // Kind
+        uint8_t online;
+        uint16_t reserved;
+        char name[NAME_SIZE];        // NUL terminated
+    };
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "snapshot needs address-free 32-bit atomics");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "snapshot needs address-free 64-bit atomics");
+    static_assert(sizeof(Record) == 64, "Record layout changed, bump LAYOUT_VERSION");
+    static_assert(sizeof(Header) % 8 == 0, "Header must keep Records 8-byte aligned");
+
+    inline uint32_t HistogramBucket(uint32_t paragon)
+    {
+        return paragon < HISTOGRAM_LEVELS ? paragon : HISTOGRAM_LEVELS - 1;
+    }
+
+    inline size_t FileSize(uint32_t capacity)
+    {
+        return sizeof(Header) + size_t(capacity) * sizeof(Record);
+    }
+
+    inline char const* KindToken(uint8_t kind)
+    {
+        switch (kind)
+        {
+            case KIND_REAL:        return "real";
+            case KIND_RNDBOT:      return "rndbot";
+            case KIND_ADDCLASSBOT: return "addclassbot";
+            case KIND_BOT:         return "bot";
+            default:               return "unknown";
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,296 @@
+#ifndef RTG_PARAGON_SNAPSHOT_WRITER_H
+#define RTG_PARAGON_SNAPSHOT_WRITER_H
+
+// Worldserver side of the memory-mapped paragon snapshot (see paragon_snapshot_format.h).
+// Single writer: every mutation goes through one mutex, readers in other processes never lock.
+
+#include "Define.h"
+#include "Log.h"
+#include "paragon_snapshot_format.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace RTG::ParagonSnapshot
+{
+    class Writer
+    {
+    public:
+        ~Writer() { Close(); }
+
+        bool IsOpen() const { return _header != nullptr; }
+
+        // Creates a fresh snapshot next to `path` and atomically renames it into place.
+        // Readers still mapping a previous file see it flagged STATE_RETIRED.
+        bool Open(std::string const& path, uint32 capacity)
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            CloseLocked();
+
+#ifdef _WIN32
+            LOG_ERROR("module", "ParagonSnapshot: memory-mapped snapshot is only supported on POSIX systems.");
+            (void)path;
+            (void)capacity;
+            return false;
+#else
+            if (path.empty() || !capacity)
+                return false;
+
+            std::string const tmpPath = path + ".tmp";
+            size_t const size = FileSize(capacity);
+
+            int fd = ::open(tmpPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0)
+            {
+                LOG_ERROR("module", "ParagonSnapshot: cannot create {}.", tmpPath);
+                return false;
+            }
+
+            if (::ftruncate(fd, off_t(size)) != 0)
+            {
+                LOG_ERROR("module", "ParagonSnapshot: cannot size {} to {} bytes.", tmpPath, size);
+                ::close(fd);
+                ::unlink(tmpPath.c_str());
+                return false;
+            }
+
+            void* map = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (map == MAP_FAILED)
+            {
+                LOG_ERROR("module", "ParagonSnapshot: cannot map {}.", tmpPath);
+                ::unlink(tmpPath.c_str());
+                return false;
+            }
+
+            // ftruncate zero-fills, so only the fixed header fields need writing.
+            Header* header = static_cast<Header*>(map);
+            header->layoutVersion = LAYOUT_VERSION;
+            header->headerSize = uint32(sizeof(Header));
+            header->recordSize = uint32(sizeof(Record));
+            header->capacity = capacity;
+            std::atomic_thread_fence(std::memory_order_release);
+            header->magic = MAGIC;
+
+            if (std::rename(tmpPath.c_str(), path.c_str()) != 0)
+            {
+                LOG_ERROR("module", "ParagonSnapshot: cannot move {} into place.", tmpPath);
+                ::munmap(map, size);
+                ::unlink(tmpPath.c_str());
+                return false;
+            }
+
+            _header = header;
+            _records = reinterpret_cast<Record*>(static_cast<char*>(map) + sizeof(Header));
+            _mappedSize = size;
+            LOG_INFO("module", "ParagonSnapshot: publishing {} slots to {}.", capacity, path);
+            return true;
+#endif
+        }
+
+        void Close()
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            CloseLocked();
+        }
+
+        // Inserts or refreshes a character. Name is only rewritten when non-empty.
+        void Publish(uint32 guid, std::string const& name, uint32 paragon, uint8 kind, bool online)
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+
+            Record* record = SlotLocked(guid, true);
+            if (!record)
+                return;
+
+            bool const isNew = record->guid == 0;
+            uint32 const oldParagon = record->paragon;
+
+            BeginWrite(record->seq);
+            record->guid = guid;
+            record->paragon = paragon;
+            record->kind = kind;
+            record->online = online ? 1 : 0;
+            if (!name.empty())
+            {
+                size_t const len = NameLength(name);
+                std::memcpy(record->name, name.data(), len);
+                std::memset(record->name + len, 0, NAME_SIZE - len);
+            }
+            EndWrite(record->seq);
+
+            if (isNew)
+                MoveHistogramLocked(nullptr, &paragon);
+            else if (oldParagon != paragon)
+                MoveHistogramLocked(&oldParagon, &paragon);
+
+            _header->generation.fetch_add(1, std::memory_order_release);
+        }
+
+        void SetParagon(uint32 guid, uint32 paragon)
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+
+            Record* record = SlotLocked(guid, false);
+            if (!record || record->paragon == paragon)
+                return;
+
+            uint32 const oldParagon = record->paragon;
+            BeginWrite(record->seq);
+            record->paragon = paragon;
+            EndWrite(record->seq);
+
+            MoveHistogramLocked(&oldParagon, &paragon);
+            _header->generation.fetch_add(1, std::memory_order_release);
+        }
+
+        void SetOnline(uint32 guid, bool online)
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+
+            Record* record = SlotLocked(guid, false);
+            if (!record || record->online == (online ? 1 : 0))
+                return;
+
+            BeginWrite(record->seq);
+            record->online = online ? 1 : 0;
+            EndWrite(record->seq);
+
+            _header->generation.fetch_add(1, std::memory_order_release);
+        }
+
+        void Remove(uint32 guid)
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+
+            auto itr = _slots.find(guid);
+            if (itr == _slots.end() || !_header)
+                return;
+
+            Record* record = &_records[itr->second];
+            uint32 const oldParagon = record->paragon;
+
+            BeginWrite(record->seq);
+            record->guid = 0;
+            record->paragon = 0;
+            record->kind = KIND_UNKNOWN;
+            record->online = 0;
+            std::memset(record->name, 0, NAME_SIZE);
+            EndWrite(record->seq);
+
+            MoveHistogramLocked(&oldParagon, nullptr);
+            _freeSlots.push_back(itr->second);
+            _slots.erase(itr);
+            _header->generation.fetch_add(1, std::memory_order_release);
+        }
+
+    private:
+        static void BeginWrite(std::atomic<uint32_t>& seq)
+        {
+            seq.store(seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        static void EndWrite(std::atomic<uint32_t>& seq)
+        {
+            seq.store(seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        // Bytes of `name` that fit before the NUL, cut back to a UTF-8 character boundary.
+        static size_t NameLength(std::string const& name)
+        {
+            if (name.size() < NAME_SIZE)
+                return name.size();
+
+            size_t len = NAME_SIZE - 1;
+            while (len > 0 && (uint8_t(name[len]) & 0xC0) == 0x80)
+                --len; // name[len] continues the character that starts before it
+            return len;
+        }
+
+        Record* SlotLocked(uint32 guid, bool create)
+        {
+            if (!_header || !guid)
+                return nullptr;
+
+            auto itr = _slots.find(guid);
+            if (itr != _slots.end())
+                return &_records[itr->second];
+
+            if (!create)
+                return nullptr;
+
+            uint32 index;
+            if (!_freeSlots.empty())
+            {
+                index = _freeSlots.back();
+                _freeSlots.pop_back();
+            }
+            else
+            {
+                index = _header->recordCount.load(std::memory_order_relaxed);
+                if (index >= _header->capacity)
+                {
+                    if (!_warnedFull)
+                        LOG_ERROR("module", "ParagonSnapshot: all {} slots in use, raise ParagonLevel.Snapshot.Capacity.", _header->capacity);
+                    _warnedFull = true;
+                    return nullptr;
+                }
+                _header->recordCount.store(index + 1, std::memory_order_release);
+            }
+
+            _slots[guid] = index;
+            return &_records[index];
+        }
+
+        void MoveHistogramLocked(uint32 const* from, uint32 const* to)
+        {
+            BeginWrite(_header->histogramSeq);
+            if (from)
+                _header->levelCounts[HistogramBucket(*from)].fetch_sub(1, std::memory_order_relaxed);
+            if (to)
+                _header->levelCounts[HistogramBucket(*to)].fetch_add(1, std::memory_order_relaxed);
+            EndWrite(_header->histogramSeq);
+        }
+
+        void CloseLocked()
+        {
+#ifndef _WIN32
+            if (_header)
+            {
+                // The file stays at the path; readers see Reader::IsStopped() until the next
+                // worldserver renames a fresh file over it.
+                _header->state.store(STATE_RETIRED, std::memory_order_release);
+                ::munmap(_header, _mappedSize);
+            }
+#endif
+            _header = nullptr;
+            _records = nullptr;
+            _mappedSize = 0;
+            _warnedFull = false;
+            _slots.clear();
+            _freeSlots.clear();
+        }
+
+        std::mutex _lock;
+        Header* _header = nullptr;
+        Record* _records = nullptr;
+        size_t _mappedSize = 0;
+        bool _warnedFull = false;
+        std::unordered_map<uint32, uint32> _slots; // guid -> record index
+        std::vector<uint32> _freeSlots;
+    };
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef RTG_PARAGON_WHO_FILTER_H
+#define RTG_PARAGON_WHO_FILTER_H
+
+// /who predicates exported by mod-paragon-levels for the core's HandleWhoOpcode
+// (see README_RTG_WHO_FILTER.txt for the integration).
+//
+// Everything here is answered from the module's online player index, filled at login:
+// no database access and O(1) per candidate row, so it is safe to call for every
+// online player before the 50-row /who limit is applied.
+
+#include "Define.h"
+#include "ObjectGuid.h"
+
+#include <limits>
+#include <string>
+
+class WorldSession;
+
+namespace RTG::ParagonWho
+{
+    enum KindMask : uint8
+    {
+        KIND_MASK_REAL        = 0x01,
+        KIND_MASK_RNDBOT      = 0x02,
+        KIND_MASK_ADDCLASSBOT = 0x04,
+        KIND_MASK_BOT         = 0x08, // bot session, subtype unknown
+        KIND_MASK_ANY_BOT     = KIND_MASK_RNDBOT | KIND_MASK_ADDCLASSBOT | KIND_MASK_BOT,
+        KIND_MASK_ALL         = KIND_MASK_REAL | KIND_MASK_ANY_BOT,
+    };
+
+    // Extra /who criteria typed by the player, e.g. "/who p:150-200 kind:real".
+    struct Filter
+    {
+        uint32 minParagon = 0;
+        uint32 maxParagon = std::numeric_limits<uint32>::max();
+        uint8 kinds = KIND_MASK_ALL;
+
+        bool IsActive() const
+        {
+            return minParagon != 0 || maxParagon != std::numeric_limits<uint32>::max() || kinds != KIND_MASK_ALL;
+        }
+    };
+
+    // Consumes one /who search word if it is a filter token and folds it into `filter`.
+    // Returns false (word untouched) for ordinary name/guild/zone words.
+    //   p:150-200  p:150  p:150+  p:-50   (also paragon:...)
+    //   kind:real  kind:bot  kind:rndbot  kind:addclassbot   (repeatable, OR-ed)
+    bool ParseFilterToken(std::string const& word, Filter& filter);
+
+    // Session is a playerbot session. O(1), no database access.
+    bool IsBotSession(WorldSession const* session);
+
+    // `viewer` enabled the hide_who_bots preference and `target` is a bot.
+    bool ShouldHideFromWho(ObjectGuid viewer, ObjectGuid target);
+
+    // `target` (online) satisfies the paragon range and kind mask of `filter`.
+    bool MatchesFilter(ObjectGuid target, Filter const& filter);
+
+    // Single per-row check for HandleWhoOpcode: bot preference plus typed filter.
+    bool AcceptWhoRow(ObjectGuid viewer, ObjectGuid target, Filter const& filter);
+}
+
+#endif
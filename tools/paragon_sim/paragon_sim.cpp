@@ -0,0 +1,406 @@
+/*
+ * paragon_sim - offline paragon progression simulator.
+ *
+ * Runs the module's own XP curve and milestone rules (src/paragon_curve.h) over a synthetic
+ * population so XpPerLevelMod / MaxParagonLevel and the reward interval can be tuned before
+ * they reach production.
+ *
+ * Every character gets an XP/hour rate and a played-hours/day figure, both log-normal. From
+ * that the simulator derives, over --days:
+ *   - days to reach each milestone (percentiles over the whole population)
+ *   - level-up and 5-interval reward issuance per day
+ *   - milestone title grants per day
+ *   - PARAGON_LEVEL telemetry events per day
+ *
+ * Usage: paragon_sim [options]     (paragon_sim --help)
+ */
+
+#include "paragon_curve.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Characters are processed in blocks so the per-level inner loop runs over a
+    // contiguous float array the compiler can vectorise.
+    static constexpr uint32_t BLOCK_SIZE = 1024;
+
+    struct Options
+    {
+        uint64_t characters = 1000000;
+        uint32_t threads = 0;
+        uint32_t days = 180;
+        uint64_t seed = 1;
+
+        // Module config (ParagonLevel.*)
+        float xpPerLevelMod = 2.0f;
+        uint32_t maxParagonLevel = 200;
+
+        // ParagonCurve::REWARD_INTERVAL; a compile-time constant in the module
+        uint32_t rewardInterval = RTG::ParagonCurve::REWARD_INTERVAL;
+
+        // player_xp_for_level.Experience at the server's MaxPlayerLevel
+        uint32_t baseXp = 1574800;
+
+        // Population model
+        double xpPerHourMedian = 450000.0;
+        double xpPerHourSigma = 0.6;
+        double hoursPerDayMedian = 2.0;
+        double hoursPerDaySigma = 0.7;
+    };
+
+    struct ThreadResult
+    {
+        std::vector<uint64_t> levelUpsPerDay;
+        std::vector<uint64_t> intervalRewardsPerDay;
+        std::vector<uint64_t> titlesPerDay;
+        std::vector<uint64_t> telemetryPerDay;
+    };
+
+    std::string Trim(std::string const& value)
+    {
+        size_t const first = value.find_first_not_of(" \t\r\n\"");
+        if (first == std::string::npos)
+            return "";
+
+        size_t const last = value.find_last_not_of(" \t\r\n\"");
+        return value.substr(first, last - first + 1);
+    }
+
+    // Reads ParagonLevel.XpPerLevelMod / MaxParagonLevel from a worldserver style .conf.
+    bool LoadModuleConfig(std::string const& path, Options& opts)
+    {
+        std::ifstream in(path);
+        if (!in)
+            return false;
+
+        std::string line;
+        while (std::getline(in, line))
+        {
+            line = Trim(line);
+            if (line.empty() || line[0] == '#' || line[0] == '[')
+                continue;
+
+            size_t const eq = line.find('=');
+            if (eq == std::string::npos)
+                continue;
+
+            std::string const key = Trim(line.substr(0, eq));
+            std::string const value = Trim(line.substr(eq + 1));
+
+            if (key == "ParagonLevel.XpPerLevelMod")
+                opts.xpPerLevelMod = std::strtof(value.c_str(), nullptr);
+            else if (key == "ParagonLevel.MaxParagonLevel")
+                opts.maxParagonLevel = uint32_t(std::strtoul(value.c_str(), nullptr, 10));
+        }
+
+        return true;
+    }
+
+    void PrintUsage(char const* argv0)
+    {
+        std::fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --config FILE          read ParagonLevel.XpPerLevelMod / MaxParagonLevel from a .conf\n"
+            "  --xp-per-level-mod F   override ParagonLevel.XpPerLevelMod (default 2)\n"
+            "  --max-paragon N        override ParagonLevel.MaxParagonLevel (default 200)\n"
+            "  --reward-interval N    paragon levels between interval rewards (default %u)\n"
+            "  --base-xp N            XP for level at MaxPlayerLevel (default 1574800)\n"
+            "  --characters N         synthetic characters (default 1000000)\n"
+            "  --days N               simulated horizon in days (default 180)\n"
+            "  --xp-median F          median XP per played hour (default 450000)\n"
+            "  --xp-sigma F           log-normal sigma of XP per hour (default 0.6)\n"
+            "  --hours-median F       median played hours per day (default 2)\n"
+            "  --hours-sigma F        log-normal sigma of hours per day (default 0.7)\n"
+            "  --threads N            worker threads (default: all cores)\n"
+            "  --seed N               RNG seed (default 1)\n",
+            argv0, RTG::ParagonCurve::REWARD_INTERVAL);
+    }
+
+    bool ParseArgs(int argc, char** argv, Options& opts)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string const arg = argv[i];
+            if (arg == "--help" || arg == "-h" || i + 1 >= argc)
+                return false;
+
+            char const* value = argv[++i];
+            if (arg == "--config")
+            {
+                if (!LoadModuleConfig(value, opts))
+                {
+                    std::fprintf(stderr, "paragon_sim: cannot read %s\n", value);
+                    return false;
+                }
+            }
+            else if (arg == "--xp-per-level-mod")
+                opts.xpPerLevelMod = std::strtof(value, nullptr);
+            else if (arg == "--max-paragon")
+                opts.maxParagonLevel = uint32_t(std::strtoul(value, nullptr, 10));
+            else if (arg == "--reward-interval")
+                opts.rewardInterval = uint32_t(std::strtoul(value, nullptr, 10));
+            else if (arg == "--base-xp")
+                opts.baseXp = uint32_t(std::strtoul(value, nullptr, 10));
+            else if (arg == "--characters")
+                opts.characters = std::strtoull(value, nullptr, 10);
+            else if (arg == "--days")
+                opts.days = uint32_t(std::strtoul(value, nullptr, 10));
+            else if (arg == "--xp-median")
+                opts.xpPerHourMedian = std::strtod(value, nullptr);
+            else if (arg == "--xp-sigma")
+                opts.xpPerHourSigma = std::strtod(value, nullptr);
+            else if (arg == "--hours-median")
+                opts.hoursPerDayMedian = std::strtod(value, nullptr);
+            else if (arg == "--hours-sigma")
+                opts.hoursPerDaySigma = std::strtod(value, nullptr);
+            else if (arg == "--threads")
+                opts.threads = uint32_t(std::strtoul(value, nullptr, 10));
+            else if (arg == "--seed")
+                opts.seed = std::strtoull(value, nullptr, 10);
+            else
+                return false;
+        }
+
+        return opts.characters && opts.days && opts.maxParagonLevel && opts.rewardInterval && opts.xpPerHourMedian > 0.0 && opts.hoursPerDayMedian > 0.0;
+    }
+
+    // cumXp[L] = total XP from paragon 0 to paragon L.
+    std::vector<float> BuildCumulativeXp(Options const& opts)
+    {
+        std::vector<float> cumXp(opts.maxParagonLevel + 1, 0.0f);
+        double total = 0.0;
+        for (uint32_t level = 0; level < opts.maxParagonLevel; ++level)
+        {
+            total += RTG::ParagonCurve::XpForNextLevel(opts.baseXp, level, opts.xpPerLevelMod, opts.maxParagonLevel);
+            cumXp[level + 1] = float(total);
+        }
+        return cumXp;
+    }
+
+    void SimulateRange(Options const& opts, std::vector<float> const& cumXp, std::vector<uint32_t> const& milestones,
+        uint64_t begin, uint64_t end, uint32_t threadIndex, std::vector<std::vector<float>>& milestoneDays, ThreadResult& out)
+    {
+        std::mt19937_64 rng(opts.seed * 0x9E3779B97F4A7C15ull + threadIndex);
+        std::lognormal_distribution<double> xpPerHour(std::log(opts.xpPerHourMedian), opts.xpPerHourSigma);
+        std::lognormal_distribution<double> hoursPerDay(std::log(opts.hoursPerDayMedian), opts.hoursPerDaySigma);
+
+        out.levelUpsPerDay.assign(opts.days, 0);
+        out.intervalRewardsPerDay.assign(opts.days, 0);
+        out.titlesPerDay.assign(opts.days, 0);
+        out.telemetryPerDay.assign(opts.days, 0);
+
+        // Per level flags, looked up instead of re-evaluated per character.
+        uint32_t const maxLevel = opts.maxParagonLevel;
+        std::vector<uint8_t> isInterval(maxLevel + 1, 0);
+        std::vector<uint8_t> isTitle(maxLevel + 1, 0);
+        std::vector<uint8_t> isTelemetry(maxLevel + 1, 0);
+        for (uint32_t level = 1; level <= maxLevel; ++level)
+        {
+            isInterval[level] = RTG::ParagonCurve::IsRewardInterval(level, opts.rewardInterval) ? 1 : 0;
+            isTitle[level] = RTG::ParagonCurve::IsTitleMilestone(level) ? 1 : 0;
+            isTelemetry[level] = RTG::ParagonCurve::IsTelemetryMilestone(level) ? 1 : 0;
+        }
+
+        float const horizon = float(opts.days);
+        float invDailyXp[BLOCK_SIZE];
+        float reachedDay[BLOCK_SIZE];
+
+        for (uint64_t blockStart = begin; blockStart < end; blockStart += BLOCK_SIZE)
+        {
+            uint32_t const count = uint32_t(std::min<uint64_t>(BLOCK_SIZE, end - blockStart));
+
+            for (uint32_t i = 0; i < count; ++i)
+                invDailyXp[i] = float(1.0 / (xpPerHour(rng) * hoursPerDay(rng)));
+
+            for (size_t m = 0; m < milestones.size(); ++m)
+            {
+                float const xp = cumXp[milestones[m]];
+                float* dst = milestoneDays[m].data() + blockStart;
+                for (uint32_t i = 0; i < count; ++i)
+                    dst[i] = xp * invDailyXp[i];
+            }
+
+            for (uint32_t level = 1; level <= maxLevel; ++level)
+            {
+                float const xp = cumXp[level];
+
+                // Vectorised: day index at which every character in the block reaches `level`.
+                for (uint32_t i = 0; i < count; ++i)
+                    reachedDay[i] = std::min(xp * invDailyXp[i], horizon);
+
+                bool const interval = isInterval[level];
+                bool const title = isTitle[level];
+                bool const telemetry = isTelemetry[level];
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    uint32_t const day = uint32_t(reachedDay[i]);
+                    if (day >= opts.days)
+                        continue;
+
+                    ++out.levelUpsPerDay[day];
+                    if (interval)
+                        ++out.intervalRewardsPerDay[day];
+                    if (title)
+                        ++out.titlesPerDay[day];
+                    if (telemetry)
+                        ++out.telemetryPerDay[day];
+                }
+            }
+        }
+    }
+
+    float Percentile(std::vector<float>& values, double p)
+    {
+        size_t const index = std::min(values.size() - 1, size_t(p * double(values.size() - 1) + 0.5));
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+
+    void PrintDays(float days, uint32_t horizon)
+    {
+        if (days >= float(horizon))
+            std::printf("%9s", "never");
+        else
+            std::printf("%9.1f", days);
+    }
+
+    void PrintDailySeries(char const* label, std::vector<uint64_t> const& perDay)
+    {
+        uint64_t total = 0;
+        uint64_t peak = 0;
+        uint32_t peakDay = 0;
+        for (uint32_t day = 0; day < perDay.size(); ++day)
+        {
+            total += perDay[day];
+            if (perDay[day] > peak)
+            {
+                peak = perDay[day];
+                peakDay = day;
+            }
+        }
+
+        auto at = [&](uint32_t day) -> unsigned long long
+        {
+            return day < perDay.size() ? perDay[day] : 0;
+        };
+
+        std::printf("%-26s %14llu %12.1f %12llu (day %3u) %12llu %12llu %12llu\n",
+            label,
+            static_cast<unsigned long long>(total),
+            double(total) / double(perDay.size()),
+            static_cast<unsigned long long>(peak), peakDay + 1,
+            at(0), at(6), at(29));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options opts;
+    if (!ParseArgs(argc, argv, opts))
+    {
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    uint32_t threads = opts.threads ? opts.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = uint32_t(std::min<uint64_t>(threads, (opts.characters + BLOCK_SIZE - 1) / BLOCK_SIZE));
+
+    auto const started = std::chrono::steady_clock::now();
+
+    std::vector<float> const cumXp = BuildCumulativeXp(opts);
+
+    std::vector<uint32_t> milestones;
+    for (uint32_t level : RTG::ParagonCurve::TELEMETRY_MILESTONES)
+        if (level <= opts.maxParagonLevel)
+            milestones.push_back(level);
+    for (uint32_t level : RTG::ParagonCurve::TITLE_MILESTONES)
+        if (level <= opts.maxParagonLevel)
+            milestones.push_back(level);
+    milestones.push_back(opts.maxParagonLevel);
+    std::sort(milestones.begin(), milestones.end());
+    milestones.erase(std::unique(milestones.begin(), milestones.end()), milestones.end());
+
+    std::vector<std::vector<float>> milestoneDays(milestones.size(), std::vector<float>(opts.characters));
+    std::vector<ThreadResult> results(threads);
+    std::vector<std::thread> workers;
+
+    // Block-aligned slices so no two threads write the same block.
+    uint64_t const blocks = (opts.characters + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    for (uint32_t t = 0; t < threads; ++t)
+    {
+        uint64_t const begin = std::min(opts.characters, blocks * t / threads * BLOCK_SIZE);
+        uint64_t const end = std::min(opts.characters, blocks * (t + 1) / threads * BLOCK_SIZE);
+        workers.emplace_back(SimulateRange, std::cref(opts), std::cref(cumXp), std::cref(milestones),
+            begin, end, t, std::ref(milestoneDays), std::ref(results[t]));
+    }
+
+    for (std::thread& worker : workers)
+        worker.join();
+
+    ThreadResult total;
+    total.levelUpsPerDay.assign(opts.days, 0);
+    total.intervalRewardsPerDay.assign(opts.days, 0);
+    total.titlesPerDay.assign(opts.days, 0);
+    total.telemetryPerDay.assign(opts.days, 0);
+    for (ThreadResult const& r : results)
+        for (uint32_t day = 0; day < opts.days; ++day)
+        {
+            total.levelUpsPerDay[day] += r.levelUpsPerDay[day];
+            total.intervalRewardsPerDay[day] += r.intervalRewardsPerDay[day];
+            total.titlesPerDay[day] += r.titlesPerDay[day];
+            total.telemetryPerDay[day] += r.telemetryPerDay[day];
+        }
+
+    std::printf("paragon_sim: %llu characters, %u days, %u threads\n",
+        static_cast<unsigned long long>(opts.characters), opts.days, threads);
+    std::printf("  XpPerLevelMod=%g MaxParagonLevel=%u reward interval=%u base XP=%u\n",
+        opts.xpPerLevelMod, opts.maxParagonLevel, opts.rewardInterval, opts.baseXp);
+    std::printf("  XP/hour median=%g sigma=%g, hours/day median=%g sigma=%g\n\n",
+        opts.xpPerHourMedian, opts.xpPerHourSigma, opts.hoursPerDayMedian, opts.hoursPerDaySigma);
+
+    std::printf("Days to reach milestone\n");
+    std::printf("%9s %12s %9s %9s %9s %9s %9s %9s\n", "paragon", "total XP", "reached%", "p10", "p25", "p50", "p90", "p99");
+    for (size_t m = 0; m < milestones.size(); ++m)
+    {
+        std::vector<float>& days = milestoneDays[m];
+        uint64_t const reached = uint64_t(std::count_if(days.begin(), days.end(),
+            [&](float d) { return d < float(opts.days); }));
+
+        std::printf("%8u%c %12.0f %8.1f%%", milestones[m],
+            RTG::ParagonCurve::IsTitleMilestone(milestones[m]) ? '*' : ' ', double(cumXp[milestones[m]]),
+            100.0 * double(reached) / double(opts.characters));
+        for (double p : { 0.10, 0.25, 0.50, 0.90, 0.99 })
+        {
+            std::printf(" ");
+            PrintDays(Percentile(days, p), opts.days);
+        }
+        std::printf("\n");
+    }
+
+    std::printf("  * grants a milestone title (ParagonLevel.TitleAtN)\n");
+
+    std::printf("\nIssuance per day\n");
+    std::printf("%-26s %14s %12s %22s %12s %12s %12s\n", "event", "total", "avg/day", "peak", "day 1", "day 7", "day 30");
+    PrintDailySeries("ON_PLAYER_LEVEL_UP_PARAGON", total.levelUpsPerDay);
+    std::string const intervalLabel = opts.rewardInterval == RTG::ParagonCurve::REWARD_INTERVAL
+        ? "..._5_INTERVAL" : "interval (every " + std::to_string(opts.rewardInterval) + ")";
+    PrintDailySeries(intervalLabel.c_str(), total.intervalRewardsPerDay);
+    PrintDailySeries("milestone titles", total.titlesPerDay);
+    PrintDailySeries("telemetry PARAGON_LEVEL", total.telemetryPerDay);
+
+    double const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    std::printf("\nfinished in %.2f s\n", seconds);
+    return 0;
+}
@@ -0,0 +1,133 @@
+/*
+ * paragon_snapshot - dump the worldserver paragon snapshot without touching MySQL.
+ *
+ * Usage:
+ *   paragon_snapshot <snapshot file> [--top N] [--online] [--kind real|rndbot|addclassbot|bot|unknown]
+ *                                     [--name NAME] [--guid GUID]
+ *
+ * Output is tab separated: rank, guid, name, paragon, kind, online
+ */
+
+#include "paragon_snapshot_reader.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace RTG::ParagonSnapshot;
+
+namespace
+{
+    struct Options
+    {
+        std::string path;
+        uint32_t top = 0;
+        bool onlineOnly = false;
+        std::string kind;
+        std::string name;
+        uint32_t guid = 0;
+    };
+
+    void PrintUsage(char const* argv0)
+    {
+        std::fprintf(stderr,
+            "Usage: %s <snapshot file> [--top N] [--online] [--kind real|rndbot|addclassbot|bot|unknown]\n"
+            "                          [--name NAME] [--guid GUID]\n",
+            argv0);
+    }
+
+    bool ParseArgs(int argc, char** argv, Options& opts)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string const arg = argv[i];
+            bool const hasValue = i + 1 < argc;
+
+            if (arg == "--top" && hasValue)
+                opts.top = uint32_t(std::strtoul(argv[++i], nullptr, 10));
+            else if (arg == "--online")
+                opts.onlineOnly = true;
+            else if (arg == "--kind" && hasValue)
+                opts.kind = argv[++i];
+            else if (arg == "--name" && hasValue)
+                opts.name = argv[++i];
+            else if (arg == "--guid" && hasValue)
+                opts.guid = uint32_t(std::strtoul(argv[++i], nullptr, 10));
+            else if (!arg.empty() && arg[0] != '-' && opts.path.empty())
+                opts.path = arg;
+            else
+                return false;
+        }
+
+        return !opts.path.empty();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options opts;
+    if (!ParseArgs(argc, argv, opts))
+    {
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    Reader reader;
+    std::string error;
+    if (!reader.Open(opts.path, &error))
+    {
+        std::fprintf(stderr, "paragon_snapshot: %s\n", error.c_str());
+        return 1;
+    }
+
+    uint32_t histogram[HISTOGRAM_LEVELS];
+    if (!reader.Histogram(histogram))
+    {
+        std::fprintf(stderr, "paragon_snapshot: rank histogram is stuck mid-update (worldserver crashed?), reopen after restart\n");
+        return 1;
+    }
+
+    // Suffix sums turn the histogram into "characters above this level" for O(1) ranks.
+    std::vector<uint32_t> above(HISTOGRAM_LEVELS + 1, 0);
+    for (uint32_t level = HISTOGRAM_LEVELS; level-- > 0;)
+        above[level] = above[level + 1] + histogram[level];
+
+    std::vector<Entry> rows;
+    reader.ForEach([&](Entry const& e)
+    {
+        if (opts.onlineOnly && !e.online)
+            return;
+        if (opts.guid && e.guid != opts.guid)
+            return;
+        if (!opts.kind.empty() && opts.kind != KindToken(e.kind))
+            return;
+        if (!opts.name.empty() && opts.name != e.name)
+            return;
+        rows.push_back(e);
+    });
+
+    std::sort(rows.begin(), rows.end(), [](Entry const& a, Entry const& b)
+    {
+        return a.paragon != b.paragon ? a.paragon > b.paragon : a.guid < b.guid;
+    });
+
+    if (opts.top && rows.size() > opts.top)
+        rows.resize(opts.top);
+
+    char const* state = "";
+    if (reader.IsStopped())
+        state = " (retired, worldserver stopped)";
+    else if (reader.IsRetired())
+        state = " (retired, worldserver restarted)";
+
+    std::printf("# generation %llu%s\n", static_cast<unsigned long long>(reader.Generation()), state);
+    std::printf("rank\tguid\tname\tparagon\tkind\tonline\n");
+    for (Entry const& e : rows)
+        std::printf("%u\t%u\t%s\t%u\t%s\t%d\n",
+            above[HistogramBucket(e.paragon) + 1] + 1, e.guid, e.name, e.paragon, KindToken(e.kind), e.online ? 1 : 0);
+
+    return 0;
+}
@@ -0,0 +1,217 @@
+#include "paragon_snapshot_reader.h"
+
+#include <cstring>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace RTG::ParagonSnapshot
+{
+    namespace
+    {
+        // A writer that dies between BeginWrite and EndWrite leaves a sequence counter odd
+        // forever, so reads give up after this many attempts instead of spinning.
+        static constexpr uint32_t MAX_READ_ATTEMPTS = 100000;
+
+        void SetError(std::string* error, std::string const& message)
+        {
+            if (error)
+                *error = message;
+        }
+
+        void Backoff(uint32_t attempt)
+        {
+            if (attempt % 64 == 63)
+                std::this_thread::yield();
+        }
+    }
+
+    Reader::~Reader()
+    {
+        Close();
+    }
+
+    bool Reader::Open(std::string const& path, std::string* error)
+    {
+        Close();
+
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            SetError(error, "cannot open " + path);
+            return false;
+        }
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(Header))
+        {
+            ::close(fd);
+            SetError(error, path + " is not a paragon snapshot");
+            return false;
+        }
+
+        size_t const size = size_t(st.st_size);
+        void* map = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED)
+        {
+            SetError(error, "cannot map " + path);
+            return false;
+        }
+
+        Header const* header = static_cast<Header const*>(map);
+        bool const valid = header->magic == MAGIC;
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (!valid
+            || header->layoutVersion != LAYOUT_VERSION
+            || header->headerSize != sizeof(Header)
+            || header->recordSize != sizeof(Record)
+            || FileSize(header->capacity) > size)
+        {
+            ::munmap(map, size);
+            SetError(error, path + " has an unknown or incomplete snapshot layout");
+            return false;
+        }
+
+        _header = header;
+        _records = reinterpret_cast<Record const*>(static_cast<char const*>(map) + sizeof(Header));
+        _mappedSize = size;
+        _path = path;
+        _dev = st.st_dev;
+        _ino = st.st_ino;
+        return true;
+    }
+
+    void Reader::Close()
+    {
+        if (_header)
+            ::munmap(const_cast<Header*>(_header), _mappedSize);
+
+        _header = nullptr;
+        _records = nullptr;
+        _mappedSize = 0;
+        _path.clear();
+        _dev = 0;
+        _ino = 0;
+    }
+
+    bool Reader::IsRetired() const
+    {
+        if (!_header || _header->state.load(std::memory_order_acquire) == STATE_RETIRED)
+            return true;
+
+        // A crashed worldserver never marks its file retired; the next one renames a fresh
+        // file over the path, so the mapping we hold is no longer the one at the path.
+        return !IsPathMapped();
+    }
+
+    bool Reader::IsStopped() const
+    {
+        return _header && _header->state.load(std::memory_order_acquire) == STATE_RETIRED && IsPathMapped();
+    }
+
+    bool Reader::IsPathMapped() const
+    {
+        struct stat st;
+        if (::stat(_path.c_str(), &st) != 0)
+            return false;
+
+        return st.st_dev == _dev && st.st_ino == _ino;
+    }
+
+    uint64_t Reader::Generation() const
+    {
+        return _header ? _header->generation.load(std::memory_order_acquire) : 0;
+    }
+
+    uint32_t Reader::SlotCount() const
+    {
+        if (!_header)
+            return 0;
+
+        uint32_t const count = _header->recordCount.load(std::memory_order_acquire);
+        return count < _header->capacity ? count : _header->capacity;
+    }
+
+    bool Reader::Read(uint32_t slot, Entry& out) const
+    {
+        if (slot >= SlotCount())
+            return false;
+
+        Record const& record = _records[slot];
+        for (uint32_t attempt = 0;; ++attempt)
+        {
+            if (attempt >= MAX_READ_ATTEMPTS)
+                return false; // writer stuck or gone mid-update
+
+            uint32_t const before = record.seq.load(std::memory_order_acquire);
+            if (before & 1)
+            {
+                Backoff(attempt); // writer is mid-update
+                continue;
+            }
+
+            out.slot = slot;
+            out.guid = record.guid;
+            out.paragon = record.paragon;
+            out.kind = record.kind;
+            out.online = record.online != 0;
+            std::memcpy(out.name, record.name, NAME_SIZE);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (record.seq.load(std::memory_order_relaxed) == before)
+                break;
+
+            Backoff(attempt);
+        }
+
+        out.name[NAME_SIZE - 1] = '\0';
+        return out.guid != 0;
+    }
+
+    bool Reader::Histogram(uint32_t (&out)[HISTOGRAM_LEVELS]) const
+    {
+        std::memset(out, 0, sizeof(out));
+        if (!_header)
+            return false;
+
+        for (uint32_t attempt = 0; attempt < MAX_READ_ATTEMPTS; ++attempt)
+        {
+            uint32_t const before = _header->histogramSeq.load(std::memory_order_acquire);
+            if (before & 1)
+            {
+                Backoff(attempt);
+                continue;
+            }
+
+            for (uint32_t i = 0; i < HISTOGRAM_LEVELS; ++i)
+                out[i] = _header->levelCounts[i].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (_header->histogramSeq.load(std::memory_order_relaxed) == before)
+                return true;
+
+            Backoff(attempt);
+        }
+
+        std::memset(out, 0, sizeof(out));
+        return false;
+    }
+
+    uint32_t Reader::Rank(uint32_t paragon) const
+    {
+        uint32_t histogram[HISTOGRAM_LEVELS];
+        if (!Histogram(histogram))
+            return 0;
+
+        uint32_t above = 0;
+        for (uint32_t level = HistogramBucket(paragon) + 1; level < HISTOGRAM_LEVELS; ++level)
+            above += histogram[level];
+
+        return above + 1;
+    }
+}
@@ -0,0 +1,101 @@
+#ifndef RTG_PARAGON_SNAPSHOT_READER_H
+#define RTG_PARAGON_SNAPSHOT_READER_H
+
+// Read-only access to the worldserver paragon snapshot (ParagonLevel.Snapshot.Path).
+//
+// The file is mapped PROT_READ; nothing is copied except the single 64-byte record being
+// validated by its seqlock. No database access, no locks shared with the worldserver.
+//
+//   RTG::ParagonSnapshot::Reader reader;
+//   if (reader.Open("/dev/shm/rtg_paragon.snapshot"))
+//       reader.ForEach([&](RTG::ParagonSnapshot::Entry const& e) { ... });
+//
+// Polling loop: when IsRetired() turns true, reopen only if !IsStopped(). A clean shutdown
+// retires the file but leaves it at the path, so reopening it just maps the same retired
+// file again until the worldserver is back.
+
+#include "paragon_snapshot_format.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <sys/types.h>
+
+namespace RTG::ParagonSnapshot
+{
+    // Validated copy of one Record.
+    struct Entry
+    {
+        uint32_t slot = 0;
+        uint32_t guid = 0;
+        uint32_t paragon = 0;
+        uint8_t kind = KIND_UNKNOWN;
+        bool online = false;
+        char name[NAME_SIZE] = { };
+    };
+
+    class Reader
+    {
+    public:
+        Reader() = default;
+        ~Reader();
+
+        Reader(Reader const&) = delete;
+        Reader& operator=(Reader const&) = delete;
+
+        bool Open(std::string const& path, std::string* error = nullptr);
+        void Close();
+
+        bool IsOpen() const { return _header != nullptr; }
+
+        // True once the worldserver closed the file, or the path now names a different file
+        // (a restarted worldserver replaced it, even if the old one crashed without retiring
+        // it). Stats the path, so poll it rather than calling it per record.
+        bool IsRetired() const;
+
+        // The worldserver retired the file on shutdown and has not replaced it yet, i.e. it is
+        // not running. Open() would map the same retired file; back off and poll again.
+        bool IsStopped() const;
+
+        // Changes on every published update; cheap way to poll for changes.
+        uint64_t Generation() const;
+
+        uint32_t SlotCount() const;
+
+        // Reads one slot. Returns false for free slots, out of range indices, or a slot that
+        // stayed mid-update for too long (writer crashed during the write).
+        bool Read(uint32_t slot, Entry& out) const;
+
+        // 1 + number of characters with a strictly higher paragon level, 0 if the histogram
+        // could not be read consistently.
+        uint32_t Rank(uint32_t paragon) const;
+
+        // Consistent copy of the per-level histogram (HISTOGRAM_LEVELS buckets). Returns false,
+        // with `out` zeroed, if the writer stayed mid-update for too long.
+        bool Histogram(uint32_t (&out)[HISTOGRAM_LEVELS]) const;
+
+        template <typename Fn>
+        void ForEach(Fn&& fn) const
+        {
+            Entry entry;
+            uint32_t const count = SlotCount();
+            for (uint32_t slot = 0; slot < count; ++slot)
+                if (Read(slot, entry))
+                    fn(entry);
+        }
+
+    private:
+        // The path still names the file that is mapped.
+        bool IsPathMapped() const;
+
+        Header const* _header = nullptr;
+        Record const* _records = nullptr;
+        size_t _mappedSize = 0;
+        std::string _path;
+        dev_t _dev = 0;
+        ino_t _ino = 0;
+    };
+}
+
+#endif